@@ -71,6 +71,230 @@ if exist build\test_xor.exe (
 )
 echo.
 
+echo Running test_plan...
+if exist build\test_plan.exe (
+    build\test_plan.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_plan
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_plan
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_plan not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_conv...
+if exist build\test_conv.exe (
+    build\test_conv.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_conv
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_conv
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_conv not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_norm...
+if exist build\test_norm.exe (
+    build\test_norm.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_norm
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_norm
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_norm not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_mixed_precision...
+if exist build\test_mixed_precision.exe (
+    build\test_mixed_precision.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_mixed_precision
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_mixed_precision
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_mixed_precision not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_training...
+if exist build\test_training.exe (
+    build\test_training.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_training
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_training
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_training not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_random...
+if exist build\test_random.exe (
+    build\test_random.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_random
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_random
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_random not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_codegen...
+if exist build\test_codegen.exe (
+    build\test_codegen.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_codegen
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_codegen
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_codegen not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_sweep...
+if exist build\test_sweep.exe (
+    build\test_sweep.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_sweep
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_sweep
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_sweep not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_ensemble...
+if exist build\test_ensemble.exe (
+    build\test_ensemble.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_ensemble
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_ensemble
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_ensemble not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_metrics...
+if exist build\test_metrics.exe (
+    build\test_metrics.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_metrics
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_metrics
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_metrics not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_recurrent...
+if exist build\test_recurrent.exe (
+    build\test_recurrent.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_recurrent
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_recurrent
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_recurrent not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_pruning...
+if exist build\test_pruning.exe (
+    build\test_pruning.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_pruning
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_pruning
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_pruning not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_pipeline...
+if exist build\test_pipeline.exe (
+    build\test_pipeline.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_pipeline
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_pipeline
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_pipeline not found
+    set /a failed+=1
+)
+echo.
+
+echo Running test_online...
+if exist build\test_online.exe (
+    build\test_online.exe
+    if %errorlevel% equ 0 (
+        echo [PASS] test_online
+        set /a passed+=1
+    ) else (
+        echo [FAIL] test_online
+        set /a failed+=1
+    )
+) else (
+    echo [FAIL] test_online not found
+    set /a failed+=1
+)
+echo.
+
 echo ================================
 echo Test Summary
 echo ================================
@@ -11,7 +11,7 @@ RED='\033[0;31m'
 NC='\033[0m' # No Color
 
 # Compile and run each test
-tests=("test_matrix" "test_dense" "test_activation" "test_xor")
+tests=("test_matrix" "test_dense" "test_activation" "test_xor" "test_plan" "test_conv" "test_norm" "test_mixed_precision" "test_training" "test_random" "test_codegen" "test_sweep" "test_ensemble" "test_metrics" "test_recurrent" "test_pruning" "test_pipeline" "test_online")
 passed=0
 failed=0
 
@@ -0,0 +1,267 @@
+#include "Codegen.h"
+#include "layers/Dense.h"
+#include "layers/Activation.h"
+#include "layers/Normalization.h"
+#include "layers/Dropout.h"
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace codegen {
+
+namespace {
+
+enum class Op { Dense, Tanh, Sigmoid, BatchNorm };
+
+struct Step {
+    Op op;
+    const Layer* layer;
+    int in_width;
+    int out_width;
+};
+
+bool isElementwise(Op op) { return op != Op::Dense; }
+
+// Exact round-trip spelling of a double (hex-float literal)
+std::string literal(double v) {
+    if (!std::isfinite(v)) {
+        throw std::invalid_argument("codegen: network has non-finite parameters");
+    }
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%a", v);
+    return buffer;
+}
+
+void emitArray(std::ostream& out, const std::string& name, const std::string& size,
+               const std::vector<double>& values) {
+    out << "alignas(64) constexpr double " << name << "[" << size << "] = {";
+    for (size_t j = 0; j < values.size(); ++j) {
+        out << (j % 4 == 0 ? "\n    " : " ") << literal(values[j]) << (j + 1 < values.size() ? "," : "");
+    }
+    out << "\n};\n";
+}
+
+void emitDense(std::ostream& out, const std::string& p, const Dense& dense, int in, int width) {
+    out << "alignas(64) constexpr double " << p << "_W[" << p << "_IN][" << p << "_OUT] = {\n";
+    for (int k = 0; k < in; ++k) {
+        out << "    {";
+        for (int j = 0; j < width; ++j) {
+            out << (j == 0 ? "" : (j % 4 == 0 ? ",\n     " : ", ")) << literal(dense.weights.data[k][j]);
+        }
+        out << "}" << (k + 1 < in ? "," : "") << "\n";
+    }
+    out << "};\n";
+    emitArray(out, p + "_B", p + "_OUT", dense.bias.data[0]);
+    out << "\n";
+
+    out << "inline void " << "layer" << p.substr(1) << "(const double* x, double* y) {\n";
+    if ((long)in * width <= UNROLL_LIMIT) {
+        // Left-to-right: the sum over k, then the bias, as in Dense::forward
+        for (int j = 0; j < width; ++j) {
+            out << "    y[" << j << "] =";
+            for (int k = 0; k < in; ++k) {
+                if (k > 0 && k % 4 == 0) out << "\n        ";
+                out << (k == 0 ? " " : " + ") << "x[" << k << "] * " << p << "_W[" << k << "][" << j << "]";
+            }
+            out << " + " << p << "_B[" << j << "];\n";
+        }
+    } else {
+        out << "    for (int j = 0; j < " << p << "_OUT; ++j) y[j] = 0.0;\n"
+            << "    for (int k = 0; k < " << p << "_IN; ++k) {\n"
+            << "        const double xk = x[k];\n"
+            << "        for (int j = 0; j < " << p << "_OUT; ++j) y[j] += xk * " << p << "_W[k][j];\n"
+            << "    }\n"
+            << "    for (int j = 0; j < " << p << "_OUT; ++j) y[j] += " << p << "_B[j];\n";
+    }
+    out << "}\n";
+}
+
+void emitElementwise(std::ostream& out, const std::string& p, const Step& step) {
+    if (step.op == Op::BatchNorm) {
+        const BatchNorm& bn = static_cast<const BatchNorm&>(*step.layer);
+        std::vector<double> inv_std(step.out_width);
+        for (int j = 0; j < step.out_width; ++j) {
+            inv_std[j] = 1.0 / std::sqrt(bn.running_var.data[0][j] + bn.getEpsilon());
+        }
+        emitArray(out, p + "_MEAN", p + "_SIZE", bn.running_mean.data[0]);
+        emitArray(out, p + "_INV_STD", p + "_SIZE", inv_std);
+        emitArray(out, p + "_GAMMA", p + "_SIZE", bn.gamma.data[0]);
+        emitArray(out, p + "_BETA", p + "_SIZE", bn.beta.data[0]);
+        out << "\n";
+    }
+
+    out << "inline void layer" << p.substr(1) << "(double* y) {\n"
+        << "    for (int j = 0; j < " << p << "_SIZE; ++j) ";
+    switch (step.op) {
+        case Op::Tanh: out << "y[j] = std::tanh(y[j]);\n"; break;
+        case Op::Sigmoid: out << "y[j] = 1.0 / (1.0 + std::exp(-y[j]));\n"; break;
+        case Op::BatchNorm:
+            out << "y[j] = " << p << "_GAMMA[j] * ((y[j] - " << p << "_MEAN[j]) * " << p << "_INV_STD[j]) + "
+                << p << "_BETA[j];\n";
+            break;
+        case Op::Dense: break;
+    }
+    out << "}\n";
+}
+
+const char* opName(Op op) {
+    switch (op) {
+        case Op::Dense: return "Dense";
+        case Op::Tanh: return "Tanh";
+        case Op::Sigmoid: return "Sigmoid";
+        case Op::BatchNorm: return "BatchNorm";
+    }
+    return "?";
+}
+
+} // namespace
+
+std::string generateHeader(const Network& net, const std::string& name, int input_size) {
+    bool valid = !name.empty() && !std::isdigit((unsigned char)name[0]);
+    for (char c : name) valid = valid && (std::isalnum((unsigned char)c) || c == '_');
+    if (!valid) {
+        throw std::invalid_argument("codegen: '" + name + "' is not a valid identifier");
+    }
+
+    const std::vector<Layer*>& layers = net.getLayers();
+    if (layers.empty()) {
+        throw std::invalid_argument("codegen: network has no layers");
+    }
+    if (input_size <= 0) {
+        for (Layer* layer : layers) {
+            if (layer->inputSize() > 0) {
+                input_size = layer->inputSize();
+                break;
+            }
+        }
+        if (input_size <= 0) {
+            throw std::invalid_argument("codegen: cannot infer input width, pass it explicitly");
+        }
+    }
+
+    // Shape validation and op selection, as in ExecutionPlan
+    std::vector<Step> steps;
+    int width = input_size;
+    int max_width = width;
+    long parameters = 0;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        Layer* layer = layers[i];
+        int required = layer->inputSize();
+        if (required > 0 && required != width) {
+            throw std::invalid_argument("codegen: layer " + std::to_string(i) + " expects " +
+                                        std::to_string(required) + " inputs, got " + std::to_string(width));
+        }
+        if (dynamic_cast<Dropout*>(layer)) continue;
+
+        Step step{Op::Dense, layer, width, layer->outputSize(width)};
+        if (Dense* dense = dynamic_cast<Dense*>(layer)) {
+            parameters += (long)dense->weights.rows * dense->weights.cols + dense->bias.cols;
+        } else if (dynamic_cast<BatchNorm*>(layer)) {
+            step.op = Op::BatchNorm;
+        } else if (Activation* act = dynamic_cast<Activation*>(layer)) {
+            if (act->kind() == Activation::Kind::Custom) {
+                throw std::invalid_argument("codegen: layer " + std::to_string(i) +
+                                            " is a custom activation and cannot be generated");
+            }
+            step.op = act->kind() == Activation::Kind::Tanh ? Op::Tanh : Op::Sigmoid;
+        } else {
+            throw std::invalid_argument("codegen: layer " + std::to_string(i) + " has no code generator");
+        }
+        steps.push_back(step);
+        width = step.out_width;
+        max_width = std::max(max_width, width);
+    }
+    if (steps.empty()) {
+        throw std::invalid_argument("codegen: network has no layers to generate");
+    }
+
+    std::string guard;
+    for (char c : name) guard += (char)std::toupper((unsigned char)c);
+    guard += "_GENERATED_H";
+
+    std::ostringstream out;
+    out << "// Generated by codegen::generateHeader. Do not edit.\n//\n// " << input_size;
+    for (const Step& step : steps) {
+        if (step.op == Op::Dense) out << " -> Dense -> " << step.out_width;
+        else out << " -> " << opName(step.op);
+    }
+    out << "\n// " << parameters << " Dense parameters\n\n"
+        << "#ifndef " << guard << "\n#define " << guard << "\n\n#include <cmath>\n\n"
+        << "namespace " << name << " {\n\n"
+        << "constexpr int INPUT_SIZE = " << input_size << ";\n"
+        << "constexpr int OUTPUT_SIZE = " << width << ";\n\n"
+        << "namespace detail {\n\n";
+
+    for (size_t s = 0; s < steps.size(); ++s) {
+        const Step& step = steps[s];
+        std::string p = "L" + std::to_string(s);
+        out << "// Layer " << s << ": " << opName(step.op);
+        if (step.op == Op::Dense) {
+            out << " " << step.in_width << " -> " << step.out_width << "\n"
+                << "constexpr int " << p << "_IN = " << step.in_width << ";\n"
+                << "constexpr int " << p << "_OUT = " << step.out_width << ";\n";
+            emitDense(out, p, static_cast<const Dense&>(*step.layer), step.in_width, step.out_width);
+        } else {
+            out << " (" << step.out_width << ")\n"
+                << "constexpr int " << p << "_SIZE = " << step.out_width << ";\n";
+            emitElementwise(out, p, step);
+        }
+        out << "\n";
+    }
+    out << "} // namespace detail\n\n";
+
+    // Buffer assignment: Dense layers ping-pong between two stack buffers,
+    // elementwise layers run in place, and the last Dense writes straight
+    // into the caller's output.
+    size_t last_dense = steps.size();
+    for (size_t s = 0; s < steps.size(); ++s) {
+        if (steps[s].op == Op::Dense) last_dense = s;
+    }
+    std::ostringstream body;
+    std::string current = "input";
+    bool used_a = false, used_b = false;
+    for (size_t s = 0; s < steps.size(); ++s) {
+        if (isElementwise(steps[s].op)) {
+            if (current == "input") {
+                body << "    for (int j = 0; j < INPUT_SIZE; ++j) a[j] = input[j];\n";
+                current = "a";
+                used_a = true;
+            }
+            body << "    detail::layer" << s << "(" << current << ");\n";
+            continue;
+        }
+        std::string target = (s == last_dense) ? "output" : (current == "a" ? "b" : "a");
+        used_a = used_a || target == "a";
+        used_b = used_b || target == "b";
+        body << "    detail::layer" << s << "(" << current << ", " << target << ");\n";
+        current = target;
+    }
+    if (current != "output") {
+        body << "    for (int j = 0; j < OUTPUT_SIZE; ++j) output[j] = " << current << "[j];\n";
+    }
+
+    out << "// One sample: input[INPUT_SIZE] -> output[OUTPUT_SIZE]\n"
+        << "inline void predict(const double* input, double* output) {\n";
+    if (used_a) out << "    alignas(64) double a[" << max_width << "];\n";
+    if (used_b) out << "    alignas(64) double b[" << max_width << "];\n";
+    out << body.str() << "}\n\n"
+        << "// n samples stored row-major\n"
+        << "inline void predict(const double* input, double* output, int n) {\n"
+        << "    for (int i = 0; i < n; ++i) predict(input + i * INPUT_SIZE, output + i * OUTPUT_SIZE);\n"
+        << "}\n\n"
+        << "} // namespace " << name << "\n\n"
+        << "#endif // " << guard << "\n";
+    return out.str();
+}
+
+void writeHeader(const Network& net, const std::string& name, const std::string& path, int input_size) {
+    std::string code = generateHeader(net, name, input_size);
+    std::ofstream file(path);
+    if (!file || !(file << code)) {
+        throw std::runtime_error("codegen: cannot write " + path);
+    }
+}
+
+} // namespace codegen
@@ -0,0 +1,34 @@
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include <string>
+#include "Network.h"
+
+// Ahead-of-time compilation of a trained Network into a standalone C++
+// header. The header depends only on <cmath>: every layer width is a
+// constexpr, weights are alignas(64) constexpr arrays written as exact
+// hex-float literals, and each layer becomes its own inline function (small
+// Dense layers fully unrolled). predict() runs on two stack buffers with no
+// virtual calls and no heap.
+//
+// Supported layers: Dense, Tanh, Sigmoid, BatchNorm (running statistics) and
+// Dropout (identity). Anything else throws std::invalid_argument. Outputs
+// match the interpreter: each dot product is summed in Matrix::multiply order.
+namespace codegen {
+
+// Dense layers with at most this many weights are emitted fully unrolled;
+// larger ones get loops with constant trip counts.
+const int UNROLL_LIMIT = 2048;
+
+// `name` becomes the namespace of the generated code and must be a valid
+// C++ identifier. input_size is inferred from the first layer when -1.
+std::string generateHeader(const Network& net, const std::string& name, int input_size = -1);
+
+// generateHeader() written to `path`; throws std::runtime_error if the file
+// cannot be written.
+void writeHeader(const Network& net, const std::string& name, const std::string& path,
+                 int input_size = -1);
+
+} // namespace codegen
+
+#endif // CODEGEN_H
@@ -0,0 +1,296 @@
+#include "Ensemble.h"
+#include "Kernels.h"
+#include "Parallel.h"
+#include "layers/Dense.h"
+#include "layers/Activation.h"
+#include "layers/Normalization.h"
+#include "layers/Dropout.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+void Ensemble::add(Network* member) {
+    members.emplace_back(member);
+    packed = false;
+    stages.clear();
+}
+
+void Ensemble::pack() {
+    if (members.empty()) {
+        throw std::invalid_argument("Ensemble: no members");
+    }
+    const int M = (int)members.size();
+
+    // Shape inference and op selection on the first member; the others must match
+    const std::vector<Layer*>& first = members[0]->getLayers();
+    input_size = -1;
+    for (Layer* layer : first) {
+        if (layer->inputSize() > 0) {
+            input_size = layer->inputSize();
+            break;
+        }
+    }
+    if (input_size <= 0) {
+        throw std::invalid_argument("Ensemble: cannot infer input width");
+    }
+
+    stages.clear();
+    int width = input_size;
+    bool shared = true;
+    for (size_t i = 0; i < first.size(); ++i) {
+        Layer* layer = first[i];
+        if (dynamic_cast<Dropout*>(layer)) continue;
+        int required = layer->inputSize();
+        if (required > 0 && required != width) {
+            throw std::invalid_argument("Ensemble: layer " + std::to_string(i) + " expects " +
+                                        std::to_string(required) + " inputs, got " + std::to_string(width));
+        }
+
+        Stage stage{Op::Dense, shared, width, layer->outputSize(width), {}, {}, {}, {}, {}, {}};
+        if (dynamic_cast<Dense*>(layer)) {
+            stage.op = Op::Dense;
+        } else if (dynamic_cast<BatchNorm*>(layer)) {
+            stage.op = Op::BatchNorm;
+        } else if (Activation* act = dynamic_cast<Activation*>(layer)) {
+            if (act->kind() == Activation::Kind::Custom) {
+                throw std::invalid_argument("Ensemble: custom activations are not supported");
+            }
+            stage.op = act->kind() == Activation::Kind::Tanh ? Op::Tanh : Op::Sigmoid;
+        } else {
+            throw std::invalid_argument("Ensemble: layer " + std::to_string(i) + " is not supported");
+        }
+        // Weight-free ops keep a shared input shared; the rest give each member its own row
+        if (stage.op == Op::Dense || stage.op == Op::BatchNorm) shared = false;
+        stages.push_back(std::move(stage));
+        width = stages.back().out_width;
+    }
+    if (shared) {
+        throw std::invalid_argument("Ensemble: members have no Dense layer");
+    }
+    output_size = width;
+
+    // Gather each member's parameter layers in the same order
+    std::vector<std::vector<const Layer*>> member_layers(M);
+    for (int m = 0; m < M; ++m) {
+        for (Layer* layer : members[m]->getLayers()) {
+            if (!dynamic_cast<Dropout*>(layer)) member_layers[m].push_back(layer);
+        }
+        if (member_layers[m].size() != stages.size()) {
+            throw std::invalid_argument("Ensemble: member " + std::to_string(m) + " has a different topology");
+        }
+    }
+
+    max_width = input_size;
+    for (size_t s = 0; s < stages.size(); ++s) {
+        Stage& stage = stages[s];
+        const int in = stage.in_width, out = stage.out_width;
+        max_width = std::max(max_width, M * out);
+
+        for (int m = 0; m < M; ++m) {
+            const Layer* layer = member_layers[m][s];
+            bool same = false;
+            switch (stage.op) {
+                case Op::Dense: {
+                    const Dense* d = dynamic_cast<const Dense*>(layer);
+                    same = d && d->weights.rows == in && d->weights.cols == out;
+                    break;
+                }
+                case Op::BatchNorm: {
+                    const BatchNorm* bn = dynamic_cast<const BatchNorm*>(layer);
+                    same = bn && bn->gamma.cols == out;
+                    break;
+                }
+                case Op::Tanh:
+                case Op::Sigmoid: {
+                    const Activation* act = dynamic_cast<const Activation*>(layer);
+                    same = act && act->kind() == (stage.op == Op::Tanh ? Activation::Kind::Tanh
+                                                                        : Activation::Kind::Sigmoid);
+                    break;
+                }
+            }
+            if (!same) {
+                throw std::invalid_argument("Ensemble: member " + std::to_string(m) + " differs at layer " +
+                                            std::to_string(s));
+            }
+        }
+
+        if (stage.op == Op::Dense) {
+            stage.weights.resize((size_t)M * in * out);
+            stage.bias.resize((size_t)M * out);
+            for (int m = 0; m < M; ++m) {
+                const Dense& d = static_cast<const Dense&>(*member_layers[m][s]);
+                for (int k = 0; k < in; ++k) {
+                    for (int j = 0; j < out; ++j) {
+                        stage.weights[((size_t)k * out + j) * M + m] = d.weights.data[k][j];
+                    }
+                }
+                for (int j = 0; j < out; ++j) stage.bias[(size_t)j * M + m] = d.bias.data[0][j];
+            }
+        } else if (stage.op == Op::BatchNorm) {
+            for (int j = 0; j < out; ++j) {
+                for (int m = 0; m < M; ++m) {
+                    const BatchNorm& bn = static_cast<const BatchNorm&>(*member_layers[m][s]);
+                    stage.mean.push_back(bn.running_mean.data[0][j]);
+                    stage.inv_std.push_back(1.0 / std::sqrt(bn.running_var.data[0][j] + bn.getEpsilon()));
+                    stage.gamma.push_back(bn.gamma.data[0][j]);
+                    stage.beta.push_back(bn.beta.data[0][j]);
+                }
+            }
+        }
+    }
+    block_rows = std::max(1, std::min(MAX_BLOCK_ROWS, L2_DOUBLES / max_width));
+    packed = true;
+}
+
+double* Ensemble::forwardBlock(const Matrix& input, int row0, int n, double* a, double* b) const {
+    const int M = (int)members.size();
+    kernels::packRows(input, row0, n, a);
+    double* x = a;
+    double* y = b;
+
+    for (const Stage& stage : stages) {
+        const int in = stage.in_width, out = stage.out_width;
+        const int in_cols = stage.shared ? in : M * in;
+        const int out_cols = M * out;
+        switch (stage.op) {
+            case Op::Dense:
+                if (stage.shared) {
+                    // One GEMM of the shared input against every member's
+                    // weights at once (columns interleaved by member)
+                    for (int i = 0; i < n; ++i) {
+                        const double* xi = x + (size_t)i * in_cols;
+                        double* yi = y + (size_t)i * out_cols;
+                        for (int c = 0; c < out_cols; ++c) yi[c] = 0.0;
+                        for (int k = 0; k < in; ++k) {
+                            const double xik = xi[k];
+                            const double* wk = stage.weights.data() + (size_t)k * out_cols;
+                            for (int c = 0; c < out_cols; ++c) yi[c] += xik * wk[c];
+                        }
+                        for (int c = 0; c < out_cols; ++c) yi[c] += stage.bias[c];
+                    }
+                } else {
+                    // Grouped GEMM: every member multiplies its own activations
+                    // by its own weights; the innermost loop runs across
+                    // members, so it stays M long even for a width-1 layer
+                    for (int i = 0; i < n; ++i) {
+                        const double* xi = x + (size_t)i * in_cols;
+                        double* yi = y + (size_t)i * out_cols;
+                        for (int c = 0; c < out_cols; ++c) yi[c] = 0.0;
+                        for (int k = 0; k < in; ++k) {
+                            const double* xk = xi + (size_t)k * M;
+                            const double* wk = stage.weights.data() + (size_t)k * out_cols;
+                            for (int j = 0; j < out; ++j) {
+                                double* yj = yi + (size_t)j * M;
+                                const double* wkj = wk + (size_t)j * M;
+                                for (int m = 0; m < M; ++m) yj[m] += xk[m] * wkj[m];
+                            }
+                        }
+                        for (int c = 0; c < out_cols; ++c) yi[c] += stage.bias[c];
+                    }
+                }
+                std::swap(x, y);
+                break;
+
+            case Op::Tanh:
+                kernels::tanhForward(x, (size_t)n * in_cols, x);
+                break;
+
+            case Op::Sigmoid:
+                kernels::sigmoidForward(x, (size_t)n * in_cols, x);
+                break;
+
+            case Op::BatchNorm:
+                for (int i = 0; i < n; ++i) {
+                    const double* xi = x + (size_t)i * in_cols;
+                    double* yi = y + (size_t)i * out_cols;
+                    for (int j = 0; j < out; ++j) {
+                        for (int m = 0; m < M; ++m) {
+                            size_t f = (size_t)j * M + m;
+                            double v = stage.shared ? xi[j] : xi[f];
+                            yi[f] = stage.gamma[f] * ((v - stage.mean[f]) * stage.inv_std[f]) + stage.beta[f];
+                        }
+                    }
+                }
+                std::swap(x, y);
+                break;
+        }
+    }
+    return x;
+}
+
+void Ensemble::forEachBlock(const Matrix& input, int threads,
+                            const std::function<void(int row0, int n, const double* y)>& write) const {
+    if (input.cols != input_size) {
+        throw std::invalid_argument("Ensemble: input has " + std::to_string(input.cols) + " columns, expected " +
+                                    std::to_string(input_size));
+    }
+    const size_t blocks = (input.rows + block_rows - 1) / block_rows;
+    parallel::forRanges(blocks, 4, threads, [&](size_t b0, size_t b1) {
+        // Uninitialized scratch, sized for the rows actually present
+        const size_t scratch = (size_t)std::min(block_rows, input.rows) * max_width;
+        std::unique_ptr<double[]> a(new double[scratch]), b(new double[scratch]);
+        for (size_t blk = b0; blk < b1; ++blk) {
+            int row0 = (int)blk * block_rows;
+            int n = std::min(block_rows, input.rows - row0);
+            write(row0, n, forwardBlock(input, row0, n, a.get(), b.get()));
+        }
+    });
+}
+
+Matrix Ensemble::predict(const Matrix& input, EnsembleReduction reduction, int threads) {
+    if (!packed) pack();
+    const int M = (int)members.size();
+    const int out = output_size;
+    Matrix output(input.rows, out);
+
+    forEachBlock(input, threads, [&](int row0, int n, const double* y) {
+        std::vector<int> votes(reduction == EnsembleReduction::Vote ? out : 0);
+        // Reduction across members while the block is still in cache
+        for (int i = 0; i < n; ++i) {
+            const double* yi = y + (size_t)i * M * out;
+            std::vector<double>& result = output.data[row0 + i];
+            if (reduction == EnsembleReduction::Mean) {
+                for (int j = 0; j < out; ++j) {
+                    double sum = 0.0;
+                    for (int m = 0; m < M; ++m) sum += yi[(size_t)j * M + m];
+                    result[j] = sum / M;
+                }
+            } else if (out == 1) {
+                int yes = 0;
+                for (int m = 0; m < M; ++m) yes += (yi[m] >= 0.5);
+                result[0] = (2 * yes > M) ? 1.0 : 0.0;
+            } else {
+                std::fill(votes.begin(), votes.end(), 0);
+                for (int m = 0; m < M; ++m) {
+                    int best = 0;
+                    for (int j = 1; j < out; ++j) {
+                        if (yi[(size_t)j * M + m] > yi[(size_t)best * M + m]) best = j;
+                    }
+                    votes[best]++;
+                }
+                int winner = (int)(std::max_element(votes.begin(), votes.end()) - votes.begin());
+                for (int j = 0; j < out; ++j) result[j] = (j == winner) ? 1.0 : 0.0;
+            }
+        }
+    });
+    return output;
+}
+
+Matrix Ensemble::predictMembers(const Matrix& input, int threads) {
+    if (!packed) pack();
+    const int M = (int)members.size();
+    const int cols = M * output_size;
+    Matrix output(input.rows, cols);
+
+    forEachBlock(input, threads, [&](int row0, int n, const double* y) {
+        for (int i = 0; i < n; ++i) {
+            const double* yi = y + (size_t)i * cols;
+            std::vector<double>& row = output.data[row0 + i];
+            for (int j = 0; j < output_size; ++j)
+                for (int m = 0; m < M; ++m) row[(size_t)m * output_size + j] = yi[(size_t)j * M + m];
+        }
+    });
+    return output;
+}
@@ -0,0 +1,88 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Network.h"
+
+// How member outputs are combined. Mean averages them; Vote takes a
+// majority: for one output, of the members predicting >= 0.5 (giving 1 when
+// more than half do, else 0); for several, of each member's argmax (giving a
+// one-hot row, ties to the lower class).
+enum class EnsembleReduction { Mean, Vote };
+
+// Inference over many Networks of identical topology as one model. pack()
+// stacks the members' parameters layer by layer: the first Dense layer,
+// whose input every member shares, becomes a single GEMM against the
+// members' weights; later Dense layers are grouped GEMMs. Activations and
+// parameters are stored member-innermost (feature j of member m at
+// j * M + m), so the inner loops run across members. predict()
+// runs all layers for a block of rows at a time and reduces across members
+// in the same pass, so per-member outputs are never stored for the whole
+// batch.
+//
+// Supported layers: Dense, Tanh, Sigmoid, BatchNorm (running statistics)
+// and Dropout (skipped). Each member's output is bit-identical to its own
+// predict().
+class Ensemble {
+public:
+    // Takes ownership, like Network::add. Discards the packed parameters.
+    void add(Network* member);
+    size_t size() const { return members.size(); }
+    Network& member(size_t i) { return *members[i]; }
+
+    // Copies the members' parameters into the grouped layout. predict()
+    // packs on first use; call it again after changing a member's weights.
+    // Throws std::invalid_argument if the members' topologies differ.
+    void pack();
+    bool isPacked() const { return packed; }
+
+    // n x outputs, rows processed in parallel blocks (threads: 0 = all cores).
+    // Both throw std::invalid_argument if input does not have the members'
+    // input width.
+    Matrix predict(const Matrix& input, EnsembleReduction reduction = EnsembleReduction::Mean,
+                   int threads = 0);
+
+    // n x (members * outputs): member m's outputs in columns [m * outputs, (m + 1) * outputs)
+    Matrix predictMembers(const Matrix& input, int threads = 0);
+
+private:
+    enum class Op { Dense, Tanh, Sigmoid, BatchNorm };
+
+    struct Stage {
+        Op op;
+        bool shared;              // input is the same for every member
+        int in_width;             // per member
+        int out_width;            // per member
+        std::vector<double> weights; // Dense: [in][out][M]
+        std::vector<double> bias;    // Dense: [out][M]
+        std::vector<double> mean, inv_std, gamma, beta; // BatchNorm: [width][M]
+    };
+
+    // Rows per block: enough to amortize the loop overhead, few enough that
+    // both activation buffers stay in L2 (L2_DOUBLES each)
+    static constexpr int MAX_BLOCK_ROWS = 32;
+    static constexpr int L2_DOUBLES = 16 * 1024;
+
+    std::vector<std::unique_ptr<Network>> members;
+    std::vector<Stage> stages;
+    int input_size = 0;
+    int output_size = 0;
+    int max_width = 0;            // widest activation row, all members together
+    int block_rows = 1;
+    bool packed = false;
+
+    // Runs rows [row0, row0 + n) through every stage; returns the buffer
+    // holding the n x (M * output_size) member outputs.
+    double* forwardBlock(const Matrix& input, int row0, int n, double* a, double* b) const;
+
+    // Runs forwardBlock over every block of input, spread over `threads`,
+    // and hands each result to write(row0, n, y). Blocks of one thread
+    // share scratch buffers. Throws std::invalid_argument on a width
+    // mismatch. Requires pack().
+    void forEachBlock(const Matrix& input, int threads,
+                      const std::function<void(int row0, int n, const double* y)>& write) const;
+};
+
+#endif // ENSEMBLE_H
@@ -0,0 +1,295 @@
+#include "ExecutionPlan.h"
+#include "layers/Dense.h"
+#include "layers/BlockSparseDense.h"
+#include "layers/Activation.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+const char* opName(ExecutionPlan::Op op) {
+    switch (op) {
+        case ExecutionPlan::Op::Dense: return "Dense";
+        case ExecutionPlan::Op::SparseDense: return "BlockSparseDense";
+        case ExecutionPlan::Op::Tanh: return "Tanh";
+        case ExecutionPlan::Op::Sigmoid: return "Sigmoid";
+        case ExecutionPlan::Op::Activation: return "Activation";
+        case ExecutionPlan::Op::Layer: return "Layer";
+    }
+    return "?";
+}
+
+bool isElementwise(ExecutionPlan::Op op) {
+    return op == ExecutionPlan::Op::Tanh || op == ExecutionPlan::Op::Sigmoid ||
+           op == ExecutionPlan::Op::Activation;
+}
+
+Matrix toMatrix(const double* src, int n, int cols) {
+    Matrix m(n, cols);
+    kernels::unpackRows(src, n, cols, m, 0);
+    return m;
+}
+
+} // namespace
+
+ExecutionPlan::ExecutionPlan(const std::vector<Layer*>& layers, int batch_size, int input_size)
+    : batch_size(batch_size), input_size(input_size), output_size(0) {
+    if (batch_size <= 0) {
+        throw std::invalid_argument("ExecutionPlan: batch size must be positive");
+    }
+    if (layers.empty()) {
+        throw std::invalid_argument("ExecutionPlan: network has no layers");
+    }
+    if (this->input_size <= 0) {
+        for (Layer* layer : layers) {
+            if (layer->inputSize() > 0) {
+                this->input_size = layer->inputSize();
+                break;
+            }
+        }
+        if (this->input_size <= 0) {
+            throw std::invalid_argument("ExecutionPlan: cannot infer input width, pass it explicitly");
+        }
+    }
+
+    // Shape validation and op selection
+    int width = this->input_size;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        Layer* layer = layers[i];
+        int required = layer->inputSize();
+        if (required > 0 && required != width) {
+            throw std::invalid_argument("ExecutionPlan: layer " + std::to_string(i) + " expects " +
+                                        std::to_string(required) + " inputs, got " + std::to_string(width));
+        }
+        int out = layer->outputSize(width);
+        if (out <= 0) {
+            throw std::invalid_argument("ExecutionPlan: layer " + std::to_string(i) +
+                                        " rejects input width " + std::to_string(width));
+        }
+
+        Step step{Op::Layer, layer, width, out, kernels::DenseKernel::Axpy, 0, 0};
+        if (dynamic_cast<Dense*>(layer)) {
+            step.op = Op::Dense;
+            step.kernel = kernels::selectDenseKernel(width, out);
+        } else if (dynamic_cast<BlockSparseDense*>(layer)) {
+            step.op = Op::SparseDense;
+        } else if (Activation* act = dynamic_cast<Activation*>(layer)) {
+            switch (act->kind()) {
+                case Activation::Kind::Tanh: step.op = Op::Tanh; break;
+                case Activation::Kind::Sigmoid: step.op = Op::Sigmoid; break;
+                case Activation::Kind::Custom: step.op = Op::Activation; break;
+            }
+        }
+        steps.push_back(step);
+        width = out;
+    }
+    output_size = width;
+
+    // Buffer planning for inference: an activation is dead as soon as the
+    // next step has consumed it, so its slot goes back to the free list.
+    // Elementwise ops run in place. Free slots are reused best-fit and grown
+    // when none is large enough.
+    std::vector<size_t> capacity{(size_t)batch_size * this->input_size};
+    std::vector<int> free_slots;
+    int current = 0;
+    for (Step& step : steps) {
+        step.infer_in = current;
+        size_t need = (size_t)batch_size * step.out_width;
+        if (isElementwise(step.op)) {
+            step.infer_out = current;
+            continue;
+        }
+        int chosen = -1;
+        for (int s : free_slots) {
+            if (capacity[s] >= need && (chosen < 0 || capacity[s] < capacity[chosen])) chosen = s;
+        }
+        if (chosen < 0 && !free_slots.empty()) {
+            chosen = free_slots.front();
+            for (int s : free_slots) {
+                if (capacity[s] > capacity[chosen]) chosen = s;
+            }
+            capacity[chosen] = need;
+        }
+        if (chosen < 0) {
+            chosen = (int)capacity.size();
+            capacity.push_back(need);
+        } else {
+            free_slots.erase(std::find(free_slots.begin(), free_slots.end(), chosen));
+        }
+        free_slots.push_back(current);
+        step.infer_out = chosen;
+        current = chosen;
+    }
+
+    size_t total = 0;
+    for (size_t cap : capacity) {
+        infer_slot_offset.push_back(total);
+        total += cap;
+    }
+    infer_arena_size = total;
+}
+
+void ExecutionPlan::runStep(const Step& step, const double* in, int n, double* out) const {
+    size_t count = (size_t)n * step.out_width;
+    switch (step.op) {
+        case Op::Dense: {
+            Dense* dense = static_cast<Dense*>(step.layer);
+            kernels::denseForward(step.kernel, in, n, step.in_width, step.out_width,
+                                  dense->weights, dense->bias, out);
+            break;
+        }
+        case Op::SparseDense: {
+            BlockSparseDense* sparse = static_cast<BlockSparseDense*>(step.layer);
+            kernels::blockSparseForward(in, n, sparse->weights, sparse->bias, out);
+            break;
+        }
+        case Op::Tanh:
+            kernels::tanhForward(in, count, out);
+            break;
+        case Op::Sigmoid:
+            kernels::sigmoidForward(in, count, out);
+            break;
+        case Op::Activation: {
+            const std::function<double(double)>& f = static_cast<Activation*>(step.layer)->function();
+            for (size_t i = 0; i < count; ++i) out[i] = f(in[i]);
+            break;
+        }
+        case Op::Layer: {
+            Matrix result = step.layer->forward(toMatrix(in, n, step.in_width));
+            kernels::packRows(result, 0, n, out);
+            break;
+        }
+    }
+}
+
+Matrix ExecutionPlan::predict(const Matrix& input) {
+    assert(input.cols == input_size);
+    if (infer_arena.empty()) infer_arena.assign(infer_arena_size, 0.0);
+    Matrix output(input.rows, output_size);
+    for (int row0 = 0; row0 < input.rows; row0 += batch_size) {
+        int n = std::min(batch_size, input.rows - row0);
+        const double* result = predictBlock(input, row0, n, infer_arena.data());
+        kernels::unpackRows(result, n, output_size, output, row0);
+    }
+    return output;
+}
+
+bool ExecutionPlan::isReentrant() const {
+    for (const Step& step : steps) {
+        if (step.op == Op::Layer) return false;
+    }
+    return true;
+}
+
+const double* ExecutionPlan::predictBlock(const Matrix& input, int row0, int n, double* arena) const {
+    assert(input.cols == input_size && n <= batch_size);
+    kernels::packRows(input, row0, n, arena + infer_slot_offset[0]);
+    for (const Step& step : steps) {
+        runStep(step, arena + infer_slot_offset[step.infer_in], n, arena + infer_slot_offset[step.infer_out]);
+    }
+    return arena + infer_slot_offset[steps.back().infer_out];
+}
+
+void ExecutionPlan::allocateTraining() {
+    size_t total = (size_t)batch_size * input_size;
+    size_t max_width = input_size;
+    size_t max_weights = 0;
+    train_act_offset.assign(1, 0);
+    for (const Step& step : steps) {
+        train_act_offset.push_back(total);
+        total += (size_t)batch_size * step.out_width;
+        max_width = std::max(max_width, (size_t)step.out_width);
+        if (step.op == Op::Dense) {
+            max_weights = std::max(max_weights, (size_t)step.in_width * step.out_width);
+        } else if (step.op == Op::SparseDense) {
+            const kernels::BlockSparseWeights& w = static_cast<BlockSparseDense*>(step.layer)->weights;
+            max_weights = std::max(max_weights, (size_t)w.storedBlocks() * w.block_rows * w.block_cols);
+        }
+    }
+    train_arena.assign(total, 0.0);
+    grad_a.assign((size_t)batch_size * max_width, 0.0);
+    grad_b.assign((size_t)batch_size * max_width, 0.0);
+    weight_scratch.assign(max_weights, 0.0);
+    target.assign((size_t)batch_size * output_size, 0.0);
+}
+
+double ExecutionPlan::trainStep(const Matrix& x, const Matrix& y, double learning_rate) {
+    assert(x.rows <= batch_size && x.cols == input_size);
+    assert(y.rows == x.rows && y.cols == output_size);
+    if (train_arena.empty()) allocateTraining();
+    const int n = x.rows;
+    double* arena = train_arena.data();
+
+    // Forward, keeping every activation
+    kernels::packRows(x, 0, n, arena + train_act_offset[0]);
+    for (size_t s = 0; s < steps.size(); ++s) {
+        runStep(steps[s], arena + train_act_offset[s], n, arena + train_act_offset[s + 1]);
+    }
+
+    const double* prediction = arena + train_act_offset.back();
+    size_t out_count = (size_t)n * output_size;
+    kernels::packRows(y, 0, n, target.data());
+    double loss = kernels::mseLoss(target.data(), prediction, out_count);
+
+    // Backward, ping-ponging between two gradient buffers
+    double* grad = grad_a.data();
+    double* next = grad_b.data();
+    kernels::msePrime(target.data(), prediction, out_count, grad);
+    for (size_t s = steps.size(); s-- > 0;) {
+        const Step& step = steps[s];
+        const double* in = arena + train_act_offset[s];
+        size_t count = (size_t)n * step.out_width;
+        switch (step.op) {
+            case Op::Dense: {
+                Dense* dense = static_cast<Dense*>(step.layer);
+                kernels::denseBackward(in, grad, n, step.in_width, step.out_width, dense->weights,
+                                       dense->bias, learning_rate, s > 0 ? next : nullptr,
+                                       weight_scratch.data());
+                std::swap(grad, next);
+                break;
+            }
+            case Op::SparseDense: {
+                BlockSparseDense* sparse = static_cast<BlockSparseDense*>(step.layer);
+                kernels::blockSparseBackward(in, grad, n, sparse->weights, sparse->bias, learning_rate,
+                                             s > 0 ? next : nullptr, weight_scratch.data());
+                std::swap(grad, next);
+                break;
+            }
+            case Op::Tanh:
+                kernels::tanhBackward(in, count, grad);
+                break;
+            case Op::Sigmoid:
+                kernels::sigmoidBackward(in, count, grad);
+                break;
+            case Op::Activation: {
+                const std::function<double(double)>& fp = static_cast<Activation*>(step.layer)->derivative();
+                for (size_t i = 0; i < count; ++i) grad[i] = grad[i] * fp(in[i]);
+                break;
+            }
+            case Op::Layer: {
+                Matrix input_gradient = step.layer->backward(toMatrix(grad, n, step.out_width), learning_rate);
+                kernels::packRows(input_gradient, 0, n, next);
+                std::swap(grad, next);
+                break;
+            }
+        }
+    }
+    return loss;
+}
+
+void ExecutionPlan::print(std::ostream& os) const {
+    os << "ExecutionPlan (batch " << batch_size << ", " << input_size << " -> " << output_size
+       << ", " << inferenceBufferCount() << " inference buffers)" << std::endl;
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const Step& step = steps[i];
+        os << "  " << i << ": " << opName(step.op) << " " << step.in_width << " -> " << step.out_width;
+        if (step.op == Op::Dense) os << " [" << kernels::denseKernelName(step.kernel) << "]";
+        if (step.op == Op::SparseDense) {
+            const BlockSparseDense* sparse = static_cast<const BlockSparseDense*>(step.layer);
+            os << " [bsr " << sparse->weights.block_rows << "x" << sparse->weights.block_cols << ", "
+               << sparse->weights.storedBlocks() << " blocks, density " << sparse->density() << "]";
+        }
+        os << "  buf" << step.infer_in << " -> buf" << step.infer_out << std::endl;
+    }
+}
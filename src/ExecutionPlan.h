@@ -0,0 +1,80 @@
+#ifndef EXECUTION_PLAN_H
+#define EXECUTION_PLAN_H
+
+#include <iostream>
+#include <vector>
+#include "Kernels.h"
+#include "layers/Layer.h"
+
+// A Network frozen for a fixed maximum batch size. Building the plan checks
+// that consecutive layer shapes agree, picks a Dense kernel per shape and
+// assigns every intermediate activation a slot in one preallocated arena.
+// Running it is a flat loop over steps: Dense and built-in activations are
+// executed by inlined kernels (BlockSparseDense too), anything else falls
+// back to Layer::forward.
+class ExecutionPlan {
+public:
+    enum class Op { Dense, SparseDense, Tanh, Sigmoid, Activation, Layer };
+
+    struct Step {
+        Op op;
+        Layer* layer;
+        int in_width;
+        int out_width;
+        kernels::DenseKernel kernel; // Op::Dense only
+        int infer_in;                // inference slot indices
+        int infer_out;
+    };
+
+    ExecutionPlan(const std::vector<Layer*>& layers, int batch_size, int input_size = -1);
+
+    int batchSize() const { return batch_size; }
+    int inputSize() const { return input_size; }
+    int outputSize() const { return output_size; }
+    const std::vector<Step>& getSteps() const { return steps; }
+
+    // Number of distinct activation buffers predict() cycles through.
+    int inferenceBufferCount() const { return (int)infer_slot_offset.size(); }
+
+    Matrix predict(const Matrix& input);
+
+    // True when every step runs through an inlined kernel. predictBlock()
+    // then touches no shared mutable state and may run on several threads
+    // at once, each with its own arena.
+    bool isReentrant() const;
+    size_t inferenceArenaSize() const { return infer_arena_size; }
+
+    // Inference on rows [row0, row0 + n) of input (n <= batch size) in a
+    // caller-owned arena of inferenceArenaSize() doubles. Returns the n x
+    // outputSize() results, which live inside the arena.
+    const double* predictBlock(const Matrix& input, int row0, int n, double* arena) const;
+
+    // One full-batch gradient step on (x, y); x.rows must not exceed the
+    // compiled batch size. Returns the MSE before the update.
+    double trainStep(const Matrix& x, const Matrix& y, double learning_rate);
+
+    void print(std::ostream& os) const;
+
+private:
+    int batch_size;
+    int input_size;
+    int output_size;
+    std::vector<Step> steps;
+
+    // predict()'s own arena, allocated on first use: callers of
+    // predictBlock() bring theirs
+    std::vector<size_t> infer_slot_offset;
+    size_t infer_arena_size = 0;
+    std::vector<double> infer_arena;
+
+    // Training keeps every activation alive for the backward pass, so it
+    // gets its own arena, allocated on the first trainStep().
+    std::vector<size_t> train_act_offset; // steps.size() + 1 entries
+    std::vector<double> train_arena;
+    std::vector<double> grad_a, grad_b, weight_scratch, target;
+
+    void runStep(const Step& step, const double* in, int n, double* out) const;
+    void allocateTraining();
+};
+
+#endif // EXECUTION_PLAN_H
@@ -0,0 +1,302 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include "Matrix.h"
+
+// Flat-buffer kernels used by the compiled execution plan.
+// Buffers are row-major (rows * cols doubles). Weights are read straight from
+// the layer's Matrix so that training through a plan updates the same storage
+// as Dense::backward. Summation order matches Matrix::multiply, so results are
+// bit-identical to the interpreted path.
+namespace kernels {
+
+enum class DenseKernel {
+    Dot,   // output width 1: one running sum per row
+    Axpy,  // generic: broadcast x[i][k] across row k of W
+    Tiled  // Axpy with the k loop blocked so a W tile stays in cache
+};
+
+// Weight tile (in doubles) above which the tiled kernel is chosen.
+const int TILE_THRESHOLD = 32 * 1024;
+const int TILE_K = 64;
+
+inline DenseKernel selectDenseKernel(int in_size, int out_size) {
+    if (out_size == 1) return DenseKernel::Dot;
+    if (in_size * out_size > TILE_THRESHOLD) return DenseKernel::Tiled;
+    return DenseKernel::Axpy;
+}
+
+inline const char* denseKernelName(DenseKernel k) {
+    switch (k) {
+        case DenseKernel::Dot: return "dot";
+        case DenseKernel::Axpy: return "axpy";
+        case DenseKernel::Tiled: return "tiled";
+    }
+    return "?";
+}
+
+// y[n x out] = x[n x in] * W + b
+inline void denseForward(DenseKernel kernel, const double* x, int n, int in_size, int out_size,
+                         const Matrix& W, const Matrix& b, double* y) {
+    const double* bias = b.data[0].data();
+    if (kernel == DenseKernel::Dot) {
+        for (int i = 0; i < n; ++i) {
+            const double* xi = x + (size_t)i * in_size;
+            double sum = 0.0;
+            for (int k = 0; k < in_size; ++k) {
+                sum += xi[k] * W.data[k][0];
+            }
+            y[i] = sum + bias[0];
+        }
+        return;
+    }
+
+    const int block = (kernel == DenseKernel::Tiled) ? TILE_K : in_size;
+    for (int i = 0; i < n; ++i) {
+        double* yi = y + (size_t)i * out_size;
+        for (int j = 0; j < out_size; ++j) yi[j] = 0.0;
+    }
+    for (int k0 = 0; k0 < in_size; k0 += block) {
+        int k1 = std::min(in_size, k0 + block);
+        for (int i = 0; i < n; ++i) {
+            const double* xi = x + (size_t)i * in_size;
+            double* yi = y + (size_t)i * out_size;
+            for (int k = k0; k < k1; ++k) {
+                const double xik = xi[k];
+                const double* wk = W.data[k].data();
+                for (int j = 0; j < out_size; ++j) {
+                    yi[j] += xik * wk[j];
+                }
+            }
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        double* yi = y + (size_t)i * out_size;
+        for (int j = 0; j < out_size; ++j) yi[j] += bias[j];
+    }
+}
+
+// Given dE/dY (g), writes dE/dX into dx (may be null for the first layer),
+// then applies W -= lr * X^T g and b -= lr * sum(g). dw is scratch of in*out.
+inline void denseBackward(const double* x, const double* g, int n, int in_size, int out_size,
+                          Matrix& W, Matrix& b, double learning_rate, double* dx, double* dw) {
+    if (dx) {
+        for (int i = 0; i < n; ++i) {
+            const double* gi = g + (size_t)i * out_size;
+            double* dxi = dx + (size_t)i * in_size;
+            for (int k = 0; k < in_size; ++k) {
+                const double* wk = W.data[k].data();
+                double sum = 0.0;
+                for (int j = 0; j < out_size; ++j) {
+                    sum += gi[j] * wk[j];
+                }
+                dxi[k] = sum;
+            }
+        }
+    }
+
+    for (size_t idx = 0; idx < (size_t)in_size * out_size; ++idx) dw[idx] = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double* xi = x + (size_t)i * in_size;
+        const double* gi = g + (size_t)i * out_size;
+        for (int k = 0; k < in_size; ++k) {
+            const double xik = xi[k];
+            double* dwk = dw + (size_t)k * out_size;
+            for (int j = 0; j < out_size; ++j) {
+                dwk[j] += xik * gi[j];
+            }
+        }
+    }
+    for (int k = 0; k < in_size; ++k) {
+        double* wk = W.data[k].data();
+        const double* dwk = dw + (size_t)k * out_size;
+        for (int j = 0; j < out_size; ++j) {
+            wk[j] = wk[j] - dwk[j] * learning_rate;
+        }
+    }
+
+    double* bias = b.data[0].data();
+    for (int j = 0; j < out_size; ++j) {
+        double sum = 0.0;
+        for (int i = 0; i < n; ++i) {
+            sum += g[(size_t)i * out_size + j];
+        }
+        bias[j] = bias[j] - sum * learning_rate;
+    }
+}
+
+// Block-compressed sparse row (BSR) weights: W (in x out) cut into
+// block_rows x block_cols tiles of which only the nonzero ones are stored.
+// Block row kb holds tiles [row_start[kb], row_start[kb + 1]), tile p
+// covering outputs from block_col[p] * block_cols. Each tile is one row of
+// `values`, row-major and zero-padded where it overhangs the matrix edge.
+struct BlockSparseWeights {
+    int in_size = 0;
+    int out_size = 0;
+    int block_rows = 1;
+    int block_cols = 1;
+    std::vector<int> row_start;
+    std::vector<int> block_col;
+    Matrix values;
+
+    int blockRowCount() const { return (in_size + block_rows - 1) / block_rows; }
+    int blockColCount() const { return (out_size + block_cols - 1) / block_cols; }
+    int storedBlocks() const { return (int)block_col.size(); }
+};
+
+// y[n x out] = x[n x in] * W + b, visiting stored tiles only. Every output
+// still sums its inputs in ascending k, so the result is bit-identical to
+// denseForward on the equivalent dense W.
+inline void blockSparseForward(const double* x, int n, const BlockSparseWeights& W, const Matrix& b, double* y) {
+    const int in_size = W.in_size, out_size = W.out_size;
+    const int br = W.block_rows, bc = W.block_cols;
+    const double* bias = b.data[0].data();
+    for (int i = 0; i < n; ++i) {
+        const double* xi = x + (size_t)i * in_size;
+        double* yi = y + (size_t)i * out_size;
+        for (int j = 0; j < out_size; ++j) yi[j] = 0.0;
+        for (int kb = 0; kb < W.blockRowCount(); ++kb) {
+            const int k0 = kb * br;
+            const int k1 = std::min(in_size, k0 + br);
+            for (int p = W.row_start[kb]; p < W.row_start[kb + 1]; ++p) {
+                const int j0 = W.block_col[p] * bc;
+                const int width = std::min(bc, out_size - j0);
+                const double* tile = W.values.data[p].data();
+                double* yj = yi + j0;
+                for (int k = k0; k < k1; ++k) {
+                    const double xik = xi[k];
+                    const double* wk = tile + (size_t)(k - k0) * bc;
+                    for (int j = 0; j < width; ++j) yj[j] += xik * wk[j];
+                }
+            }
+        }
+        for (int j = 0; j < out_size; ++j) yi[j] += bias[j];
+    }
+}
+
+// denseBackward for BSR weights. Only stored tiles are updated, so the
+// sparsity pattern is fixed during training. dw is scratch of
+// storedBlocks() * block_rows * block_cols.
+inline void blockSparseBackward(const double* x, const double* g, int n, BlockSparseWeights& W, Matrix& b,
+                                double learning_rate, double* dx, double* dw) {
+    const int in_size = W.in_size, out_size = W.out_size;
+    const int br = W.block_rows, bc = W.block_cols;
+    const size_t tile_size = (size_t)br * bc;
+
+    if (dx) {
+        for (int i = 0; i < n; ++i) {
+            const double* gi = g + (size_t)i * out_size;
+            double* dxi = dx + (size_t)i * in_size;
+            for (int k = 0; k < in_size; ++k) dxi[k] = 0.0;
+            for (int kb = 0; kb < W.blockRowCount(); ++kb) {
+                const int k0 = kb * br;
+                const int k1 = std::min(in_size, k0 + br);
+                for (int p = W.row_start[kb]; p < W.row_start[kb + 1]; ++p) {
+                    const int j0 = W.block_col[p] * bc;
+                    const int width = std::min(bc, out_size - j0);
+                    const double* tile = W.values.data[p].data();
+                    for (int k = k0; k < k1; ++k) {
+                        const double* wk = tile + (size_t)(k - k0) * bc;
+                        double sum = 0.0;
+                        for (int j = 0; j < width; ++j) sum += gi[j0 + j] * wk[j];
+                        dxi[k] += sum;
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t idx = 0; idx < (size_t)W.storedBlocks() * tile_size; ++idx) dw[idx] = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double* xi = x + (size_t)i * in_size;
+        const double* gi = g + (size_t)i * out_size;
+        for (int kb = 0; kb < W.blockRowCount(); ++kb) {
+            const int k0 = kb * br;
+            const int k1 = std::min(in_size, k0 + br);
+            for (int p = W.row_start[kb]; p < W.row_start[kb + 1]; ++p) {
+                const int j0 = W.block_col[p] * bc;
+                const int width = std::min(bc, out_size - j0);
+                double* dtile = dw + (size_t)p * tile_size;
+                for (int k = k0; k < k1; ++k) {
+                    const double xik = xi[k];
+                    double* dwk = dtile + (size_t)(k - k0) * bc;
+                    for (int j = 0; j < width; ++j) dwk[j] += xik * gi[j0 + j];
+                }
+            }
+        }
+    }
+    for (int p = 0; p < W.storedBlocks(); ++p) {
+        double* tile = W.values.data[p].data();
+        const double* dtile = dw + (size_t)p * tile_size;
+        for (size_t idx = 0; idx < tile_size; ++idx) tile[idx] = tile[idx] - dtile[idx] * learning_rate;
+    }
+
+    double* bias = b.data[0].data();
+    for (int j = 0; j < out_size; ++j) {
+        double sum = 0.0;
+        for (int i = 0; i < n; ++i) {
+            sum += g[(size_t)i * out_size + j];
+        }
+        bias[j] = bias[j] - sum * learning_rate;
+    }
+}
+
+inline void tanhForward(const double* x, size_t count, double* y) {
+    for (size_t i = 0; i < count; ++i) y[i] = std::tanh(x[i]);
+}
+
+// g *= tanh'(x), in place
+inline void tanhBackward(const double* x, size_t count, double* g) {
+    for (size_t i = 0; i < count; ++i) {
+        double t = std::tanh(x[i]);
+        g[i] = g[i] * (1 - t * t);
+    }
+}
+
+inline void sigmoidForward(const double* x, size_t count, double* y) {
+    for (size_t i = 0; i < count; ++i) y[i] = 1.0 / (1.0 + std::exp(-x[i]));
+}
+
+inline void sigmoidBackward(const double* x, size_t count, double* g) {
+    for (size_t i = 0; i < count; ++i) {
+        double s = 1.0 / (1.0 + std::exp(-x[i]));
+        g[i] = g[i] * (s * (1 - s));
+    }
+}
+
+inline double mseLoss(const double* y_true, const double* y_pred, size_t count) {
+    double sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        double diff = y_true[i] - y_pred[i];
+        sum += diff * diff;
+    }
+    return sum / count;
+}
+
+inline void msePrime(const double* y_true, const double* y_pred, size_t count, double* grad) {
+    int n = (int)count;
+    for (size_t i = 0; i < count; ++i) {
+        grad[i] = 2.0 * (y_pred[i] - y_true[i]) / n;
+    }
+}
+
+// Copies rows [row0, row0 + n) of m into a flat buffer.
+inline void packRows(const Matrix& m, int row0, int n, double* dst) {
+    for (int i = 0; i < n; ++i) {
+        const std::vector<double>& row = m.data[row0 + i];
+        for (int j = 0; j < m.cols; ++j) dst[(size_t)i * m.cols + j] = row[j];
+    }
+}
+
+inline void unpackRows(const double* src, int n, int cols, Matrix& m, int row0) {
+    for (int i = 0; i < n; ++i) {
+        std::vector<double>& row = m.data[row0 + i];
+        for (int j = 0; j < cols; ++j) row[j] = src[(size_t)i * cols + j];
+    }
+}
+
+} // namespace kernels
+
+#endif // KERNELS_H
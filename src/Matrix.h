@@ -3,9 +3,10 @@
 
 #include <vector>
 #include <iostream>
-#include <random>
+#include <algorithm>
 #include <cmath>
 #include <cassert>
+#include "Random.h"
 
 class Matrix {
 public:
@@ -19,15 +20,22 @@ public:
         data.resize(r, std::vector<double>(c, 0.0));
     }
 
+    // He initialization roughly: normal(0, sqrt(2 / rows)). Each call takes
+    // the next stream of the global seed (see Random::seed), so a program
+    // that seeds once initializes identically on every run.
     void setRandom() {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::normal_distribution<> d(0, 1);
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                data[i][j] = d(gen) * sqrt(2.0 / rows); // He initialization roughly
+        setRandom(Random::getSeed(), Random::nextStream());
+    }
+
+    // Element (i, j) is element i * cols + j of the stream, so rows can be
+    // filled in parallel without changing the result.
+    void setRandom(uint64_t seed, uint64_t stream, int threads = 0) {
+        const double stddev = sqrt(2.0 / rows);
+        parallel::forRanges(rows, std::max(1, 16384 / std::max(1, cols)), threads, [&](size_t r0, size_t r1) {
+            for (size_t i = r0; i < r1; ++i) {
+                Random::fillNormal(data[i].data(), cols, (uint64_t)i * cols, 0.0, stddev, seed, stream, 1);
             }
-        }
+        });
     }
 
     static Matrix multiply(const Matrix& A, const Matrix& B) {
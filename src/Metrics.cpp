@@ -0,0 +1,162 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+Metrics::Metrics(int outputs, const EvaluationOptions& options)
+    : output_size(outputs), num_classes(outputs == 1 ? 2 : outputs), options(options) {
+    if (outputs <= 0 || options.auc_bins <= 0 || !(options.score_max > options.score_min)) {
+        throw std::invalid_argument("Metrics: invalid output count or AUC histogram range");
+    }
+    confusion_counts.assign((size_t)num_classes * num_classes, 0);
+    positive_hist.assign((size_t)num_classes * options.auc_bins, 0);
+    negative_hist.assign((size_t)num_classes * options.auc_bins, 0);
+}
+
+int Metrics::classify(const double* row) const {
+    if (output_size == 1) return row[0] >= options.threshold ? 1 : 0;
+    int best = 0;
+    for (int j = 1; j < output_size; ++j) {
+        if (row[j] > row[best]) best = j;
+    }
+    return best;
+}
+
+int Metrics::bin(double score) const {
+    double t = (score - options.score_min) / (options.score_max - options.score_min);
+    int b = (int)(t * options.auc_bins);
+    return std::max(0, std::min(options.auc_bins - 1, b));
+}
+
+void Metrics::add(const double* y_true, const double* y_pred, int rows) {
+    const int bins = options.auc_bins;
+    for (int i = 0; i < rows; ++i) {
+        const double* t = y_true + (size_t)i * output_size;
+        const double* p = y_pred + (size_t)i * output_size;
+        for (int j = 0; j < output_size; ++j) {
+            double diff = p[j] - t[j];
+            abs_error += std::abs(diff);
+            squared_error += diff * diff;
+        }
+
+        int actual = classify(t);
+        int predicted = classify(p);
+        confusion_counts[(size_t)actual * num_classes + predicted]++;
+
+        if (output_size == 1) {
+            // Class 1's score is the output itself
+            std::vector<uint64_t>& hist = actual == 1 ? positive_hist : negative_hist;
+            hist[(size_t)bins + bin(p[0])]++;
+        } else {
+            for (int c = 0; c < num_classes; ++c) {
+                std::vector<uint64_t>& hist = actual == c ? positive_hist : negative_hist;
+                hist[(size_t)c * bins + bin(p[c])]++;
+            }
+        }
+    }
+    count += rows;
+}
+
+void Metrics::merge(const Metrics& other) {
+    assert(other.output_size == output_size && other.options.auc_bins == options.auc_bins);
+    count += other.count;
+    abs_error += other.abs_error;
+    squared_error += other.squared_error;
+    for (size_t i = 0; i < confusion_counts.size(); ++i) confusion_counts[i] += other.confusion_counts[i];
+    for (size_t i = 0; i < positive_hist.size(); ++i) {
+        positive_hist[i] += other.positive_hist[i];
+        negative_hist[i] += other.negative_hist[i];
+    }
+}
+
+double Metrics::mae() const {
+    return abs_error / ((double)count * output_size);
+}
+
+double Metrics::mse() const {
+    return squared_error / ((double)count * output_size);
+}
+
+double Metrics::accuracy() const {
+    uint64_t correct = 0;
+    for (int c = 0; c < num_classes; ++c) correct += confusion(c, c);
+    return (double)correct / count;
+}
+
+double Metrics::precision(int c) const {
+    uint64_t predicted = 0;
+    for (int a = 0; a < num_classes; ++a) predicted += confusion(a, c);
+    return predicted ? (double)confusion(c, c) / predicted : std::numeric_limits<double>::quiet_NaN();
+}
+
+double Metrics::recall(int c) const {
+    uint64_t actual = 0;
+    for (int p = 0; p < num_classes; ++p) actual += confusion(c, p);
+    return actual ? (double)confusion(c, c) / actual : std::numeric_limits<double>::quiet_NaN();
+}
+
+static double meanDefined(const std::vector<double>& values) {
+    double sum = 0.0;
+    int n = 0;
+    for (double v : values) {
+        if (!std::isnan(v)) {
+            sum += v;
+            n++;
+        }
+    }
+    return n ? sum / n : std::numeric_limits<double>::quiet_NaN();
+}
+
+double Metrics::macroPrecision() const {
+    std::vector<double> values;
+    for (int c = 0; c < num_classes; ++c) values.push_back(precision(c));
+    return meanDefined(values);
+}
+
+double Metrics::macroRecall() const {
+    std::vector<double> values;
+    for (int c = 0; c < num_classes; ++c) values.push_back(recall(c));
+    return meanDefined(values);
+}
+
+double Metrics::rocAuc(int c) const {
+    // Probability that a random positive outscores a random negative; pairs
+    // in the same bin count as ties (one half)
+    const int bins = options.auc_bins;
+    const uint64_t* pos = positive_hist.data() + (size_t)c * bins;
+    const uint64_t* neg = negative_hist.data() + (size_t)c * bins;
+    double positives = 0.0, negatives = 0.0, wins = 0.0;
+    for (int b = 0; b < bins; ++b) {
+        wins += pos[b] * (negatives + 0.5 * neg[b]);
+        positives += pos[b];
+        negatives += neg[b];
+    }
+    if (positives == 0.0 || negatives == 0.0) return std::numeric_limits<double>::quiet_NaN();
+    return wins / (positives * negatives);
+}
+
+double Metrics::rocAuc() const {
+    if (output_size == 1) return rocAuc(1);
+    std::vector<double> values;
+    for (int c = 0; c < num_classes; ++c) values.push_back(rocAuc(c));
+    return meanDefined(values);
+}
+
+void Metrics::print(std::ostream& os) const {
+    os << "Filas evaluadas: " << count << "\n"
+       << "Exactitud: " << accuracy() * 100.0 << "%\n"
+       << "MAE: " << mae() << "  MSE: " << mse() << "\n"
+       << "ROC-AUC: " << rocAuc() << "\n"
+       << "Matriz de confusión (fila = real, columna = predicha):\n";
+    for (int a = 0; a < num_classes; ++a) {
+        os << "  ";
+        for (int p = 0; p < num_classes; ++p) os << std::setw(10) << confusion(a, p);
+        os << "\n";
+    }
+    for (int c = 0; c < num_classes; ++c) {
+        os << "Clase " << c << ": precisión " << precision(c) << ", exhaustividad " << recall(c) << "\n";
+    }
+}
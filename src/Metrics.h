@@ -0,0 +1,75 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+struct EvaluationOptions {
+    int chunk_rows = 4096;       // rows predicted per step and per thread
+    int threads = 0;             // 0 = all cores
+
+    // A single output is a binary classifier: class 1 when the value is
+    // >= threshold. With several outputs the class is the argmax.
+    double threshold = 0.5;
+
+    // ROC-AUC is computed from per-class score histograms of auc_bins bins
+    // over [score_min, score_max] (scores outside are clamped), so memory
+    // does not grow with the number of rows.
+    int auc_bins = 1024;
+    double score_min = 0.0;
+    double score_max = 1.0;
+};
+
+// Streaming evaluation metrics. Every statistic is a sum or a count, so
+// accumulators filled on different threads (or different chunks of a
+// dataset) combine exactly with merge().
+class Metrics {
+public:
+    Metrics(int outputs, const EvaluationOptions& options = EvaluationOptions());
+
+    // `rows` rows of targets and predictions, row-major, outputs() wide
+    void add(const double* y_true, const double* y_pred, int rows);
+    void merge(const Metrics& other);
+
+    uint64_t rows() const { return count; }
+    int outputs() const { return output_size; }
+    int classes() const { return num_classes; }
+
+    double mae() const;                 // over every output element
+    double mse() const;
+    double accuracy() const;
+
+    uint64_t confusion(int actual, int predicted) const {
+        return confusion_counts[(size_t)actual * num_classes + predicted];
+    }
+    double precision(int c) const;      // NaN if nothing was predicted as c
+    double recall(int c) const;         // NaN if c never occurs
+    double macroPrecision() const;      // mean over classes where defined
+    double macroRecall() const;
+
+    // Binary: AUC of the single output. Several outputs: mean one-vs-rest
+    // AUC over the classes that have both positives and negatives. NaN if
+    // there is none. Exact up to the histogram resolution.
+    double rocAuc() const;
+    double rocAuc(int c) const;
+
+    void print(std::ostream& os) const;
+
+private:
+    int output_size;
+    int num_classes;
+    EvaluationOptions options;
+
+    uint64_t count = 0;
+    double abs_error = 0.0;
+    double squared_error = 0.0;
+    std::vector<uint64_t> confusion_counts; // classes x classes, [actual][predicted]
+    std::vector<uint64_t> positive_hist;    // classes x auc_bins
+    std::vector<uint64_t> negative_hist;
+
+    int classify(const double* row) const;
+    int bin(double score) const;
+};
+
+#endif // METRICS_H
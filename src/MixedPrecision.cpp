@@ -0,0 +1,276 @@
+#include "MixedPrecision.h"
+#include "layers/Dense.h"
+#include "layers/Activation.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+// fp32 scratch per widened panel: small enough to stay in L2 while every
+// row of the other operand streams past it
+constexpr int PANEL_FLOATS = 16 * 1024;
+
+int panelRows(int width) {
+    return std::max(1, PANEL_FLOATS / std::max(1, width));
+}
+
+// C[m x n] (fp32) = A[m x k] * B[k x n], both operands 16-bit. B is widened
+// a panel of rows at a time, so each of its elements is converted once per
+// call instead of once per row of A.
+template <HalfFormat F>
+void gemmHalf(const uint16_t* A, const uint16_t* B, int m, int k, int n, float* C, std::vector<float>& panel) {
+    const int rows = panelRows(n);
+    panel.resize((size_t)std::min(rows, k) * n);
+    std::fill(C, C + (size_t)m * n, 0.0f);
+    for (int p0 = 0; p0 < k; p0 += rows) {
+        const int p1 = std::min(k, p0 + rows);
+        half::widen<F>(B + (size_t)p0 * n, (size_t)(p1 - p0) * n, panel.data());
+        for (int i = 0; i < m; ++i) {
+            float* ci = C + (size_t)i * n;
+            const uint16_t* ai = A + (size_t)i * k;
+            for (int p = p0; p < p1; ++p) {
+                const float a = half::toFloat<F>(ai[p]);
+                const float* bp = panel.data() + (size_t)(p - p0) * n;
+                for (int j = 0; j < n; ++j) ci[j] += a * bp[j];
+            }
+        }
+    }
+}
+
+bool finite(const std::vector<float>& v) {
+    for (float f : v) {
+        if (!std::isfinite(f)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+MixedPrecisionTrainer::MixedPrecisionTrainer(Network& net, HalfFormat format, LossScaler scaler)
+    : format(format), scaler(scaler) {
+    for (Layer* layer : net.getLayers()) {
+        int width = steps.empty() ? 0 : steps.back().out_width;
+        if (Dense* dense = dynamic_cast<Dense*>(layer)) {
+            Param p;
+            p.layer = dense;
+            p.in = dense->weights.rows;
+            p.out = dense->weights.cols;
+            if (!steps.empty() && width != p.in) {
+                throw std::invalid_argument("MixedPrecisionTrainer: layer shapes do not match");
+            }
+            for (int k = 0; k < p.in; ++k) {
+                for (int j = 0; j < p.out; ++j) p.master_w.push_back((float)dense->weights.data[k][j]);
+            }
+            for (int j = 0; j < p.out; ++j) p.master_b.push_back((float)dense->bias.data[0][j]);
+            p.w16.resize(p.master_w.size());
+            p.grad_w.resize(p.master_w.size());
+            p.grad_b.resize(p.out);
+            refreshHalfWeights(p);
+            steps.push_back(Step{Op::Dense, (int)params.size(), p.in, p.out});
+            params.push_back(p);
+            continue;
+        }
+        Activation* act = dynamic_cast<Activation*>(layer);
+        if (!act || act->kind() == Activation::Kind::Custom || steps.empty()) {
+            throw std::invalid_argument("MixedPrecisionTrainer: only Dense, Tanh and Sigmoid layers "
+                                        "starting with a Dense are supported");
+        }
+        Op op = act->kind() == Activation::Kind::Tanh ? Op::Tanh : Op::Sigmoid;
+        steps.push_back(Step{op, -1, width, width});
+    }
+    if (steps.empty()) {
+        throw std::invalid_argument("MixedPrecisionTrainer: network has no layers");
+    }
+}
+
+void MixedPrecisionTrainer::refreshHalfWeights(Param& p) {
+    for (size_t i = 0; i < p.master_w.size(); ++i) {
+        p.w16[i] = half::fromFloat(p.master_w[i], format);
+    }
+}
+
+void MixedPrecisionTrainer::syncToNetwork() {
+    for (Param& p : params) {
+        for (int k = 0; k < p.in; ++k) {
+            for (int j = 0; j < p.out; ++j) p.layer->weights.data[k][j] = p.master_w[(size_t)k * p.out + j];
+        }
+        for (int j = 0; j < p.out; ++j) p.layer->bias.data[0][j] = p.master_b[j];
+    }
+}
+
+size_t MixedPrecisionTrainer::workingSetBytes(int n) const {
+    size_t elements = (size_t)n * steps.front().in_width;
+    for (const Step& step : steps) elements += (size_t)n * step.out_width;
+    for (const Param& p : params) elements += p.w16.size();
+    return elements * sizeof(uint16_t);
+}
+
+void MixedPrecisionTrainer::forward(const Matrix& x) {
+    if (format == HalfFormat::BF16) {
+        forwardAs<HalfFormat::BF16>(x);
+    } else {
+        forwardAs<HalfFormat::FP16>(x);
+    }
+}
+
+template <HalfFormat F>
+void MixedPrecisionTrainer::forwardAs(const Matrix& x) {
+    const int n = x.rows;
+    acts.resize(steps.size() + 1);
+    acts[0].resize((size_t)n * x.cols);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < x.cols; ++j) acts[0][(size_t)i * x.cols + j] = half::fromFloat<F>((float)x.data[i][j]);
+    }
+
+    for (size_t s = 0; s < steps.size(); ++s) {
+        const Step& step = steps[s];
+        const std::vector<uint16_t>& in = acts[s];
+        std::vector<uint16_t>& out = acts[s + 1];
+        size_t count = (size_t)n * step.out_width;
+        out.resize(count);
+        if (step.op == Op::Dense) {
+            const Param& p = params[step.param];
+            accum.resize(count);
+            gemmHalf<F>(in.data(), p.w16.data(), n, p.in, p.out, accum.data(), panel);
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < p.out; ++j) {
+                    out[(size_t)i * p.out + j] = half::fromFloat<F>(accum[(size_t)i * p.out + j] + p.master_b[j]);
+                }
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                float z = half::toFloat<F>(in[i]);
+                float a = step.op == Op::Tanh ? std::tanh(z) : 1.0f / (1.0f + std::exp(-z));
+                out[i] = half::fromFloat<F>(a);
+            }
+        }
+    }
+}
+
+Matrix MixedPrecisionTrainer::predict(const Matrix& x) {
+    forward(x);
+    const std::vector<uint16_t>& out = acts.back();
+    int cols = steps.back().out_width;
+    Matrix result(x.rows, cols);
+    for (int i = 0; i < x.rows; ++i) {
+        for (int j = 0; j < cols; ++j) result.data[i][j] = half::toFloat(out[(size_t)i * cols + j], format);
+    }
+    return result;
+}
+
+double MixedPrecisionTrainer::train(const Matrix& x, const Matrix& y, int epochs, double learning_rate) {
+    double loss = 0;
+    for (int e = 0; e < epochs; ++e) {
+        loss = format == HalfFormat::BF16 ? stepAs<HalfFormat::BF16>(x, y, learning_rate)
+                                          : stepAs<HalfFormat::FP16>(x, y, learning_rate);
+        if ((e + 1) % 100 == 0) {
+            std::cout << "Epoch " << (e + 1) << "/" << epochs << " error=" << loss
+                      << " loss_scale=" << scaler.scale << std::endl;
+        }
+    }
+
+    syncToNetwork();
+    return loss;
+}
+
+template <HalfFormat F>
+double MixedPrecisionTrainer::stepAs(const Matrix& x, const Matrix& y, double learning_rate) {
+    const int n = x.rows;
+    const int out_cols = steps.back().out_width;
+    const size_t out_count = (size_t)n * out_cols;
+
+    forwardAs<F>(x);
+
+    // MSE in fp32; the gradient is scaled before it is rounded to 16 bits
+    const std::vector<uint16_t>& pred = acts.back();
+    grad.resize(out_count);
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < out_cols; ++j) {
+            size_t idx = (size_t)i * out_cols + j;
+            float diff = half::toFloat<F>(pred[idx]) - (float)y.data[i][j];
+            sum += (double)diff * diff;
+            grad[idx] = half::fromFloat<F>(2.0f * diff / out_count * scaler.scale);
+        }
+    }
+    const double loss = sum / out_count;
+
+    // Backward: gradients are computed for every layer before any update
+    // so an overflow anywhere can skip the whole step.
+    bool overflow = false;
+    for (size_t s = steps.size(); s-- > 0;) {
+        const Step& step = steps[s];
+        const std::vector<uint16_t>& in = acts[s];
+        if (step.op != Op::Dense) {
+            for (size_t i = 0; i < (size_t)n * step.out_width; ++i) {
+                float z = half::toFloat<F>(in[i]);
+                float d;
+                if (step.op == Op::Tanh) {
+                    float t = std::tanh(z);
+                    d = 1 - t * t;
+                } else {
+                    float sg = 1.0f / (1.0f + std::exp(-z));
+                    d = sg * (1 - sg);
+                }
+                grad[i] = half::fromFloat<F>(half::toFloat<F>(grad[i]) * d);
+            }
+            continue;
+        }
+
+        Param& p = params[step.param];
+        // The layer's output gradient is read by both GEMMs below: widen it once
+        grad32.resize((size_t)n * p.out);
+        half::widen<F>(grad.data(), grad32.size(), grad32.data());
+
+        // dW = X^T G, db = sum(G), accumulated in fp32
+        std::fill(p.grad_w.begin(), p.grad_w.end(), 0.0f);
+        std::fill(p.grad_b.begin(), p.grad_b.end(), 0.0f);
+        row32.resize(p.in);
+        for (int i = 0; i < n; ++i) {
+            const float* gi = grad32.data() + (size_t)i * p.out;
+            half::widen<F>(in.data() + (size_t)i * p.in, p.in, row32.data());
+            for (int k = 0; k < p.in; ++k) {
+                const float xik = row32[k];
+                float* dwk = p.grad_w.data() + (size_t)k * p.out;
+                for (int j = 0; j < p.out; ++j) dwk[j] += xik * gi[j];
+            }
+            for (int j = 0; j < p.out; ++j) p.grad_b[j] += gi[j];
+        }
+        overflow = overflow || !finite(p.grad_w) || !finite(p.grad_b);
+
+        // dX = G W^T, W widened a panel of rows (inputs) at a time
+        if (s > 0) {
+            next.resize((size_t)n * p.in);
+            const int rows = panelRows(p.out);
+            panel.resize((size_t)std::min(rows, p.in) * p.out);
+            for (int k0 = 0; k0 < p.in; k0 += rows) {
+                const int k1 = std::min(p.in, k0 + rows);
+                half::widen<F>(p.w16.data() + (size_t)k0 * p.out, (size_t)(k1 - k0) * p.out, panel.data());
+                for (int i = 0; i < n; ++i) {
+                    const float* gi = grad32.data() + (size_t)i * p.out;
+                    for (int k = k0; k < k1; ++k) {
+                        const float* wk = panel.data() + (size_t)(k - k0) * p.out;
+                        float sum_k = 0.0f;
+                        for (int j = 0; j < p.out; ++j) sum_k += gi[j] * wk[j];
+                        next[(size_t)i * p.in + k] = half::fromFloat<F>(sum_k);
+                    }
+                }
+            }
+            std::swap(grad, next);
+        }
+    }
+
+    const float used_scale = scaler.scale;
+    if (scaler.update(overflow)) {
+        // Unscale and apply to the fp32 masters, then refresh the copies
+        const float step_size = (float)learning_rate / used_scale;
+        for (Param& p : params) {
+            for (size_t i = 0; i < p.master_w.size(); ++i) p.master_w[i] -= step_size * p.grad_w[i];
+            for (int j = 0; j < p.out; ++j) p.master_b[j] -= step_size * p.grad_b[j];
+            refreshHalfWeights(p);
+        }
+    }
+    return loss;
+}
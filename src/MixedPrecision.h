@@ -0,0 +1,202 @@
+#ifndef MIXED_PRECISION_H
+#define MIXED_PRECISION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "Network.h"
+
+class Dense;
+
+// 16-bit storage formats. bf16 keeps the fp32 exponent (same range, 8-bit
+// mantissa); fp16 is IEEE half (5-bit exponent, 11-bit mantissa, max 65504).
+enum class HalfFormat { BF16, FP16 };
+
+namespace half {
+
+inline uint32_t floatBits(float f) {
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    return x;
+}
+
+inline float bitsFloat(uint32_t x) {
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+// Round-to-nearest-even truncation of the low 16 bits
+inline uint16_t floatToBf16(float f) {
+    uint32_t x = floatBits(f);
+    if ((x & 0x7FFFFFFF) > 0x7F800000) return (uint16_t)((x >> 16) | 0x40); // quiet NaN
+    x += 0x7FFF + ((x >> 16) & 1);
+    return (uint16_t)(x >> 16);
+}
+
+inline float bf16ToFloat(uint16_t h) {
+    return bitsFloat((uint32_t)h << 16);
+}
+
+inline uint16_t floatToFp16(float f) {
+    uint32_t x = floatBits(f);
+    uint32_t sign = (x >> 16) & 0x8000;
+    uint32_t mant = x & 0x007FFFFF;
+    int exp = (int)((x >> 23) & 0xFF);
+    if (exp == 0xFF) return (uint16_t)(sign | 0x7C00 | (mant ? 0x200 : 0));
+
+    exp = exp - 127 + 15;
+    if (exp >= 0x1F) return (uint16_t)(sign | 0x7C00); // overflow to inf
+    if (exp <= 0) {
+        // Subnormal half: value = m * 2^-24
+        if (exp < -10) return (uint16_t)sign;
+        mant |= 0x00800000;
+        int shift = 14 - exp;
+        uint32_t m = mant >> shift;
+        uint32_t rem = mant & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (m & 1))) m++;
+        return (uint16_t)(sign | m);
+    }
+    uint32_t h = sign | ((uint32_t)exp << 10) | (mant >> 13);
+    uint32_t rem = mant & 0x1FFF;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) h++; // a carry rounds up the exponent
+    return (uint16_t)h;
+}
+
+inline float fp16ToFloat(uint16_t h) {
+    uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    int exp = (h >> 10) & 0x1F;
+    uint32_t mant = h & 0x3FF;
+    if (exp == 0) {
+        if (mant == 0) return bitsFloat(sign);
+        exp = 1;
+        while (!(mant & 0x400)) {
+            mant <<= 1;
+            exp--;
+        }
+        mant &= 0x3FF;
+    } else if (exp == 0x1F) {
+        return bitsFloat(sign | 0x7F800000 | (mant << 13));
+    }
+    return bitsFloat(sign | ((uint32_t)(exp + 127 - 15) << 23) | (mant << 13));
+}
+
+// Compile-time format, for loops that must not branch on it per element
+template <HalfFormat F>
+inline uint16_t fromFloat(float f) {
+    if constexpr (F == HalfFormat::BF16) return floatToBf16(f);
+    else return floatToFp16(f);
+}
+
+template <HalfFormat F>
+inline float toFloat(uint16_t h) {
+    if constexpr (F == HalfFormat::BF16) return bf16ToFloat(h);
+    else return fp16ToFloat(h);
+}
+
+// dst[i] = src[i] widened to fp32, for i < count
+template <HalfFormat F>
+inline void widen(const uint16_t* src, size_t count, float* dst) {
+    for (size_t i = 0; i < count; ++i) dst[i] = toFloat<F>(src[i]);
+}
+
+inline uint16_t fromFloat(float f, HalfFormat format) {
+    return format == HalfFormat::BF16 ? fromFloat<HalfFormat::BF16>(f) : fromFloat<HalfFormat::FP16>(f);
+}
+
+inline float toFloat(uint16_t h, HalfFormat format) {
+    return format == HalfFormat::BF16 ? toFloat<HalfFormat::BF16>(h) : toFloat<HalfFormat::FP16>(h);
+}
+
+} // namespace half
+
+// Dynamic loss scaling: the loss gradient is multiplied by `scale` before it
+// is stored in 16 bits so small values do not flush to zero. A step whose
+// gradients overflow is skipped and the scale halved; after `growth_interval`
+// clean steps in a row the scale doubles again.
+struct LossScaler {
+    float scale;
+    int growth_interval;
+    int good_steps = 0;
+    int skipped_steps = 0;
+
+    explicit LossScaler(float initial_scale = 65536.0f, int growth_interval = 200)
+        : scale(initial_scale), growth_interval(growth_interval) {}
+
+    // Returns true if the step may be applied.
+    bool update(bool overflow) {
+        if (overflow) {
+            scale = std::max(1.0f, scale * 0.5f);
+            good_steps = 0;
+            skipped_steps++;
+            return false;
+        }
+        if (++good_steps >= growth_interval) {
+            scale *= 2.0f;
+            good_steps = 0;
+        }
+        return true;
+    }
+};
+
+// Trains a Dense/Tanh/Sigmoid network with 16-bit activations and 16-bit
+// weight copies. GEMMs widen each operand to fp32 and accumulate in fp32;
+// the update is applied to fp32 master weights, which are written back to
+// the Dense layers (fp64) by syncToNetwork() at the end of train(). Every
+// 16-bit weight and gradient is widened once per GEMM, a panel of rows at a
+// time into a small fp32 scratch buffer, and the format is a template
+// parameter of the hot loops rather than a per-element branch.
+class MixedPrecisionTrainer {
+public:
+    MixedPrecisionTrainer(Network& net, HalfFormat format = HalfFormat::BF16,
+                          LossScaler scaler = LossScaler());
+
+    // Full-batch training like Network::train. Returns the last loss.
+    double train(const Matrix& x, const Matrix& y, int epochs, double learning_rate);
+    Matrix predict(const Matrix& x);
+    void syncToNetwork();
+
+    const LossScaler& getScaler() const { return scaler; }
+
+    // Bytes of 16-bit activations and weight copies touched per step for a
+    // batch of n rows (the same data held in fp64 would take 4x as much).
+    // The fp32 GEMM scratch is one panel plus one gradient, not counted.
+    size_t workingSetBytes(int n) const;
+
+private:
+    enum class Op { Dense, Tanh, Sigmoid };
+
+    struct Param {
+        Dense* layer;
+        int in, out;
+        std::vector<float> master_w, master_b;
+        std::vector<uint16_t> w16;
+        std::vector<float> grad_w, grad_b;
+    };
+
+    struct Step {
+        Op op;
+        int param; // index into params for Op::Dense
+        int in_width, out_width;
+    };
+
+    HalfFormat format;
+    LossScaler scaler;
+    std::vector<Param> params;
+    std::vector<Step> steps;
+    std::vector<std::vector<uint16_t>> acts; // steps.size() + 1 activations
+    std::vector<uint16_t> grad, next;
+    std::vector<float> accum;
+    std::vector<float> panel, grad32, row32; // fp32 scratch for the GEMMs
+
+    void forward(const Matrix& x);
+    void refreshHalfWeights(Param& p);
+
+    template <HalfFormat F> void forwardAs(const Matrix& x);
+    // One full-batch step; returns the loss before the update
+    template <HalfFormat F> double stepAs(const Matrix& x, const Matrix& y, double learning_rate);
+};
+
+#endif // MIXED_PRECISION_H
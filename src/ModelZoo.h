@@ -0,0 +1,78 @@
+#ifndef MODEL_ZOO_H
+#define MODEL_ZOO_H
+
+#include <cmath>
+#include "Network.h"
+#include "layers/Dense.h"
+#include "layers/Activation.h"
+#include "layers/Normalization.h"
+
+// Small reference networks trained under fixed seeds. Building one twice
+// gives bit-identical weights, so a header generated from it at build time
+// can be checked against a freshly built copy.
+namespace models {
+
+// The XOR network from main.cpp: 2 -> 3 -> 1
+inline void buildXor(Network& net) {
+    Random::seed(1);
+    Matrix X(4, 2);
+    X.data = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    Matrix Y(4, 1);
+    Y.data = {{0}, {1}, {1}, {0}};
+
+    net.add(new Dense(2, 3));
+    net.add(new Tanh());
+    net.add(new Dense(3, 1));
+    net.add(new Tanh());
+
+    TrainingOptions options;
+    options.epochs = 2000;
+    options.schedule = LearningRateSchedule::constant(0.1);
+    options.verbose_every = 0;
+    net.fit(X, Y, options);
+}
+
+// The main_large.cpp task (sign of a weighted sin/cos sum), n samples
+inline void makeLargeDataset(int n, Matrix& X, Matrix& Y) {
+    const int input_dim = 10;
+    X = Matrix(n, input_dim);
+    Y = Matrix(n, 1);
+    for (int i = 0; i < n; ++i) {
+        Random::fillUniform(X.data[i].data(), input_dim, (uint64_t)i * input_dim, -3.14159, 3.14159, 7, 0, 1);
+        double sum = 0;
+        for (int j = 0; j < input_dim; ++j) {
+            double v = (j % 2 == 0) ? std::sin(X.data[i][j]) : std::cos(X.data[i][j]);
+            sum += v * (j + 1) / input_dim;
+        }
+        Y.data[i][0] = (sum > 0) ? 1.0 : 0.0;
+    }
+}
+
+// The main_large.cpp network: 10 -> 50 -> 30 -> 10 -> 1 with BatchNorm
+inline void buildLarge(Network& net, int epochs = 50) {
+    Random::seed(2);
+    Matrix X, Y;
+    makeLargeDataset(200, X, Y);
+
+    net.add(new Dense(10, 50));
+    net.add(new BatchNorm(50));
+    net.add(new Tanh());
+    net.add(new Dense(50, 30));
+    net.add(new BatchNorm(30));
+    net.add(new Tanh());
+    net.add(new Dense(30, 10));
+    net.add(new BatchNorm(10));
+    net.add(new Tanh());
+    net.add(new Dense(10, 1));
+    net.add(new Sigmoid());
+
+    TrainingOptions options;
+    options.epochs = epochs;
+    options.schedule = LearningRateSchedule::constant(0.1);
+    options.verbose_every = 0;
+    net.fit(X, Y, options);
+}
+
+} // namespace models
+
+#endif // MODEL_ZOO_H
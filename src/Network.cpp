@@ -1,6 +1,15 @@
 #include "Network.h"
 #include "losses/MSE.h"
+#include "layers/Dense.h"
+#include "layers/Normalization.h"
+#include "layers/BlockSparseDense.h"
+#include "Parallel.h"
+#include "Pruning.h"
+#include <algorithm>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 
 Network::~Network() {
     for (Layer* layer : layers) {
@@ -10,9 +19,83 @@ Network::~Network() {
 
 void Network::add(Layer* layer) {
     layers.push_back(layer);
+    plan.reset();
+}
+
+std::unique_ptr<Network> Network::clone() const {
+    std::unique_ptr<Network> copy(new Network);
+    for (size_t i = 0; i < layers.size(); ++i) {
+        Layer* layer = layers[i]->clone();
+        if (!layer) {
+            throw std::invalid_argument("Network::clone: layer " + std::to_string(i) + " cannot be copied");
+        }
+        copy->add(layer);
+    }
+    return copy;
+}
+
+void Network::compile(int batch_size, int input_size) {
+    plan.reset(new ExecutionPlan(layers, batch_size, input_size));
+}
+
+int Network::foldBatchNorm() {
+    int folded = 0;
+    for (size_t i = 0; i + 1 < layers.size(); ++i) {
+        Dense* dense = dynamic_cast<Dense*>(layers[i]);
+        BatchNorm* bn = dynamic_cast<BatchNorm*>(layers[i + 1]);
+        if (!dense || !bn || bn->inputSize() != dense->weights.cols) continue;
+
+        // gamma * (xW + b - mean) / sqrt(var + eps) + beta
+        //   = x (W * s) + ((b - mean) * s + beta),  s = gamma / sqrt(var + eps)
+        for (int j = 0; j < dense->weights.cols; ++j) {
+            double s = bn->gamma.data[0][j] / std::sqrt(bn->running_var.data[0][j] + bn->getEpsilon());
+            for (int k = 0; k < dense->weights.rows; ++k) {
+                dense->weights.data[k][j] *= s;
+            }
+            dense->bias.data[0][j] = (dense->bias.data[0][j] - bn->running_mean.data[0][j]) * s
+                                     + bn->beta.data[0][j];
+        }
+        delete bn;
+        layers.erase(layers.begin() + i + 1);
+        folded++;
+    }
+    if (folded > 0) plan.reset();
+    return folded;
+}
+
+int Network::convertToBlockSparse(int block_rows, int block_cols, double min_sparsity) {
+    int converted = 0;
+    for (Layer*& layer : layers) {
+        Dense* dense = dynamic_cast<Dense*>(layer);
+        if (!dense) continue;
+        BlockSparseDense* sparse = new BlockSparseDense(*dense, block_rows, block_cols);
+        if (1.0 - sparse->density() < min_sparsity) {
+            delete sparse;
+            continue;
+        }
+        delete dense;
+        layer = sparse;
+        converted++;
+    }
+    if (converted > 0) plan.reset();
+    return converted;
+}
+
+void Network::compileForInference(int batch_size, int input_size) {
+    foldBatchNorm();
+    compile(batch_size, input_size);
+}
+
+void Network::setTraining(bool training) {
+    for (Layer* layer : layers) {
+        layer->setTraining(training);
+    }
 }
 
 Matrix Network::predict(const Matrix& input) {
+    if (plan && input.cols == plan->inputSize()) {
+        return plan->predict(input);
+    }
     Matrix output = input;
     for (Layer* layer : layers) {
         output = layer->forward(output);
@@ -20,28 +103,256 @@ Matrix Network::predict(const Matrix& input) {
     return output;
 }
 
+double Network::trainEpoch(const Matrix& x_train, const Matrix& y_train, double learning_rate) {
+    // The compiled plan runs whole batches only; larger sets take the
+    // layer-by-layer path below.
+    if (plan && x_train.rows <= plan->batchSize() && x_train.cols == plan->inputSize()) {
+        return plan->trainStep(x_train, y_train, learning_rate);
+    }
+
+    // Forward (layer by layer: the layers must see their inputs for backward)
+    Matrix output = x_train;
+    for (Layer* layer : layers) {
+        output = layer->forward(output);
+    }
+
+    // Error
+    double total_error = MSE::loss(y_train, output);
+
+    // Backward
+    Matrix grad = MSE::prime(y_train, output);
+    for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
+        grad = (*it)->backward(grad, learning_rate);
+    }
+    return total_error;
+}
+
 void Network::train(const Matrix& x_train, const Matrix& y_train, int epochs, double learning_rate) {
+    setTraining(true);
     for (int e = 0; e < epochs; ++e) {
-        double total_error = 0;
-        
-        // Stochastic Gradient Descent (one sample at a time) or Batch?
-        // My Matrix implementation supports batch if rows > 1.
-        // Let's assume x_train is (samples, features) and y_train is (samples, output_dim).
-        
-        // Forward
-        Matrix output = predict(x_train);
-        
-        // Error
-        total_error = MSE::loss(y_train, output);
-        
-        // Backward
-        Matrix grad = MSE::prime(y_train, output);
-        for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
-            grad = (*it)->backward(grad, learning_rate);
-        }
+        double total_error = trainEpoch(x_train, y_train, learning_rate);
 
         if ((e + 1) % 100 == 0) {
             std::cout << "Epoch " << (e + 1) << "/" << epochs << " error=" << total_error << std::endl;
         }
     }
+    setTraining(false);
+}
+
+// Runs in inference mode, batch_size rows at a time, so validation never
+// materializes activations for the whole set.
+double Network::validationLoss(const Matrix& x_val, const Matrix& y_val, int batch_size) {
+    setTraining(false);
+    double sum = 0;
+    for (int row0 = 0; row0 < x_val.rows; row0 += batch_size) {
+        int n = std::min(batch_size, x_val.rows - row0);
+        Matrix xb(n, x_val.cols);
+        Matrix yb(n, y_val.cols);
+        for (int i = 0; i < n; ++i) {
+            xb.data[i] = x_val.data[row0 + i];
+            yb.data[i] = y_val.data[row0 + i];
+        }
+        sum += MSE::loss(yb, predict(xb)) * n;
+    }
+    setTraining(true);
+    return sum / x_val.rows;
+}
+
+namespace {
+
+// Shared driver of both evaluate() overloads. chunk(row0, n, x, y) returns
+// the matrices and first row holding rows [row0, row0 + n); x and y are the
+// calling thread's scratch matrices, which it may fill or ignore.
+template <typename Chunk>
+Metrics evaluateChunks(const ExecutionPlan& plan, uint64_t rows, const EvaluationOptions& options, Chunk chunk) {
+    const int batch = plan.batchSize();
+    const int out = plan.outputSize();
+    const size_t chunks = (size_t)((rows + batch - 1) / batch);
+    const int threads = plan.isReentrant() ? options.threads : 1;
+
+    std::mutex mutex;
+    std::vector<std::pair<size_t, Metrics>> partial;
+    parallel::forRanges(chunks, 1, threads, [&](size_t c0, size_t c1) {
+        Metrics local(out, options);
+        Matrix x_scratch(batch, plan.inputSize()), y_scratch(batch, out);
+        std::vector<double> arena(plan.inferenceArenaSize());
+        std::vector<double> target((size_t)batch * out);
+        for (size_t c = c0; c < c1; ++c) {
+            uint64_t row0 = (uint64_t)c * batch;
+            int n = (int)std::min<uint64_t>(batch, rows - row0);
+            int x_row = 0, y_row = 0;
+            const Matrix* x = &x_scratch;
+            const Matrix* y = &y_scratch;
+            chunk(row0, n, x_scratch, y_scratch, x, x_row, y, y_row);
+            const double* prediction = plan.predictBlock(*x, x_row, n, arena.data());
+            kernels::packRows(*y, y_row, n, target.data());
+            local.add(target.data(), prediction, n);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        partial.emplace_back(c0, std::move(local));
+    });
+
+    // Merge in row order so the result depends only on the thread count
+    std::sort(partial.begin(), partial.end(),
+              [](const std::pair<size_t, Metrics>& a, const std::pair<size_t, Metrics>& b) { return a.first < b.first; });
+    Metrics total(out, options);
+    for (const std::pair<size_t, Metrics>& p : partial) total.merge(p.second);
+    return total;
+}
+
+} // namespace
+
+const ExecutionPlan& Network::chunkPlan(int chunk_rows, int input_size, std::unique_ptr<ExecutionPlan>& own) {
+    if (plan && plan->batchSize() == chunk_rows && (input_size < 0 || plan->inputSize() == input_size)) {
+        return *plan;
+    }
+    own.reset(new ExecutionPlan(layers, chunk_rows, input_size));
+    return *own;
+}
+
+Metrics Network::evaluate(const Matrix& x, const Matrix& y, const EvaluationOptions& options) {
+    if (x.rows != y.rows) {
+        throw std::invalid_argument("Network::evaluate: " + std::to_string(x.rows) + " input rows but " +
+                                    std::to_string(y.rows) + " label rows");
+    }
+    setTraining(false);
+    std::unique_ptr<ExecutionPlan> own;
+    const ExecutionPlan& chunk_plan = chunkPlan(options.chunk_rows, x.cols, own);
+    if (y.cols != chunk_plan.outputSize()) {
+        throw std::invalid_argument("Network::evaluate: labels have " + std::to_string(y.cols) +
+                                    " columns, the network produces " + std::to_string(chunk_plan.outputSize()));
+    }
+    // Rows are read in place; the scratch matrices stay unused
+    return evaluateChunks(chunk_plan, x.rows, options,
+                          [&](uint64_t row0, int, Matrix&, Matrix&, const Matrix*& xs, int& x_row,
+                              const Matrix*& ys, int& y_row) {
+                              xs = &x;
+                              ys = &y;
+                              x_row = y_row = (int)row0;
+                          });
+}
+
+Metrics Network::evaluate(uint64_t rows, const RowSource& fill, const EvaluationOptions& options) {
+    setTraining(false);
+    std::unique_ptr<ExecutionPlan> own;
+    const ExecutionPlan& chunk_plan = chunkPlan(options.chunk_rows, -1, own);
+    return evaluateChunks(chunk_plan, rows, options,
+                          [&](uint64_t row0, int n, Matrix& xs, Matrix& ys, const Matrix*&, int&,
+                              const Matrix*&, int&) { fill(row0, n, xs, ys); });
+}
+
+std::vector<Matrix> Network::saveParameters() {
+    std::vector<Matrix> saved;
+    for (Layer* layer : layers) {
+        for (Matrix* p : layer->parameters()) {
+            saved.push_back(*p);
+        }
+    }
+    return saved;
+}
+
+void Network::loadParameters(const std::vector<Matrix>& saved) {
+    size_t i = 0;
+    for (Layer* layer : layers) {
+        for (Matrix* p : layer->parameters()) {
+            assert(i < saved.size() && saved[i].rows == p->rows && saved[i].cols == p->cols);
+            *p = saved[i++];
+        }
+    }
+}
+
+TrainingHistory Network::fit(const Matrix& x, const Matrix& y, const TrainingOptions& options) {
+    int val_rows = (int)(x.rows * options.validation_split);
+    int train_rows = x.rows - val_rows;
+    assert(train_rows > 0);
+
+    Matrix x_train(train_rows, x.cols), y_train(train_rows, y.cols);
+    Matrix x_val(val_rows, x.cols), y_val(val_rows, y.cols);
+    for (int i = 0; i < x.rows; ++i) {
+        if (i < train_rows) {
+            x_train.data[i] = x.data[i];
+            y_train.data[i] = y.data[i];
+        } else {
+            x_val.data[i - train_rows] = x.data[i];
+            y_val.data[i - train_rows] = y.data[i];
+        }
+    }
+    return fit(x_train, y_train, x_val, y_val, options);
+}
+
+TrainingHistory Network::fit(const Matrix& x_train, const Matrix& y_train,
+                             const Matrix& x_val, const Matrix& y_val, TrainingOptions options) {
+    TrainingHistory history;
+    const bool validate = x_val.rows > 0 && options.validation_every > 0;
+    std::vector<Matrix> best_parameters;
+    int passes_without_improvement = 0;
+
+    const int batch = options.batch_size > 0 ? std::min(options.batch_size, x_train.rows) : x_train.rows;
+    std::vector<int> order(x_train.rows);
+    for (int i = 0; i < x_train.rows; ++i) order[i] = i;
+
+    std::unique_ptr<BlockPruner> pruner;
+    if (options.pruning.sparsity > 0.0) pruner.reset(new BlockPruner(*this, options.pruning));
+
+    setTraining(true);
+    for (int e = 0; e < options.epochs; ++e) {
+        double lr = options.schedule.rate(e);
+        if (pruner && pruner->prunesAt(e, options.epochs)) {
+            pruner->prune(pruner->scheduledSparsity(e, options.epochs));
+        }
+        if (batch == x_train.rows) {
+            history.train_loss.push_back(trainEpoch(x_train, y_train, lr));
+            if (pruner) pruner->applyMasks();
+        } else {
+            if (options.shuffle) Random::shuffle(order, Random::getSeed(), Random::nextStream());
+            double loss = 0.0;
+            for (int start = 0; start < x_train.rows; start += batch) {
+                int rows = std::min(batch, x_train.rows - start);
+                Matrix x_batch(rows, x_train.cols), y_batch(rows, y_train.cols);
+                for (int i = 0; i < rows; ++i) {
+                    x_batch.data[i] = x_train.data[order[start + i]];
+                    y_batch.data[i] = y_train.data[order[start + i]];
+                }
+                loss += trainEpoch(x_batch, y_batch, lr) * rows;
+                if (pruner) pruner->applyMasks();
+            }
+            history.train_loss.push_back(loss / x_train.rows);
+        }
+        history.epochs_run = e + 1;
+
+        bool last = (e + 1 == options.epochs);
+        if (validate && ((e + 1) % options.validation_every == 0 || last)) {
+            double val_loss = validationLoss(x_val, y_val, options.validation_batch);
+            history.validation_loss.push_back(val_loss);
+            options.schedule.observe(val_loss);
+
+            // While the pruner is still raising sparsity a checkpoint would hold
+            // weights never fine-tuned under the final masks, and stopping
+            // would leave the target sparsity unreached
+            const bool settled = !pruner || e >= pruner->endEpoch(options.epochs);
+            if (settled && val_loss < history.best_validation_loss - options.min_delta) {
+                history.best_validation_loss = val_loss;
+                history.best_epoch = e + 1;
+                passes_without_improvement = 0;
+                if (options.restore_best) best_parameters = saveParameters();
+            } else if (settled && options.patience > 0 && ++passes_without_improvement >= options.patience) {
+                history.stopped_early = true;
+            }
+        }
+
+        if (options.verbose_every > 0 && ((e + 1) % options.verbose_every == 0 || history.stopped_early)) {
+            std::cout << "Epoch " << (e + 1) << "/" << options.epochs << " error=" << history.train_loss.back();
+            if (!history.validation_loss.empty()) std::cout << " val_error=" << history.validation_loss.back();
+            std::cout << " lr=" << lr << std::endl;
+        }
+        if (history.stopped_early) break;
+    }
+    setTraining(false);
+
+    if (options.restore_best && !best_parameters.empty()) {
+        loadParameters(best_parameters);
+        if (pruner) pruner->applyMasks();
+    }
+    if (pruner) history.sparsity = pruner->sparsity();
+    return history;
 }
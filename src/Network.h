@@ -1,18 +1,90 @@
 #ifndef NETWORK_H
 #define NETWORK_H
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #include "layers/Layer.h"
+#include "ExecutionPlan.h"
+#include "Metrics.h"
+#include "Training.h"
 
 class Network {
 private:
     std::vector<Layer*> layers;
+    std::unique_ptr<ExecutionPlan> plan;
+
+    void setTraining(bool training);
+
+    // One full-batch gradient step; returns the loss before the update.
+    double trainEpoch(const Matrix& x_train, const Matrix& y_train, double learning_rate);
+    double validationLoss(const Matrix& x_val, const Matrix& y_val, int batch_size);
+
+    // The compiled plan when it matches chunk_rows and input_size (-1: any),
+    // else a new plan owned by `own`
+    const ExecutionPlan& chunkPlan(int chunk_rows, int input_size, std::unique_ptr<ExecutionPlan>& own);
 
 public:
     ~Network();
     void add(Layer* layer);
     Matrix predict(const Matrix& input);
     void train(const Matrix& input, const Matrix& output, int epochs, double learning_rate);
+    const std::vector<Layer*>& getLayers() const { return layers; }
+
+    // Training with a validation set, learning-rate schedule and optional
+    // early stopping (see TrainingOptions). The first overload holds out the
+    // last options.validation_split of the rows for validation. With
+    // options.pruning.sparsity > 0 a BlockPruner prunes the Dense layers
+    // gradually along the way; restored best weights are re-masked.
+    TrainingHistory fit(const Matrix& x, const Matrix& y, const TrainingOptions& options);
+    TrainingHistory fit(const Matrix& x_train, const Matrix& y_train,
+                        const Matrix& x_val, const Matrix& y_val, TrainingOptions options);
+
+    // Streams (x, y) through a private inference plan options.chunk_rows
+    // rows at a time, spread over options.threads threads, and accumulates
+    // Metrics. Predictions for the whole set are never materialized. The
+    // compiled plan is reused when its batch size is options.chunk_rows.
+    // Throws std::invalid_argument if the shapes of x, y and the network
+    // disagree.
+    // Networks with layers the plan cannot run reentrantly (e.g. Conv2D)
+    // are evaluated on one thread.
+    Metrics evaluate(const Matrix& x, const Matrix& y, const EvaluationOptions& options = EvaluationOptions());
+
+    // Same over `rows` rows produced on demand: fill(row0, n, x, y) writes
+    // rows [row0, row0 + n) into the first n rows of x and y. It is called
+    // concurrently for disjoint ranges and must be thread-safe. Memory stays
+    // at one chunk per thread however many rows there are.
+    using RowSource = std::function<void(uint64_t row0, int n, Matrix& x, Matrix& y)>;
+    Metrics evaluate(uint64_t rows, const RowSource& fill, const EvaluationOptions& options = EvaluationOptions());
+
+    // Copies of every layer's parameters, in layer order.
+    std::vector<Matrix> saveParameters();
+    void loadParameters(const std::vector<Matrix>& saved);
+
+    // A deep copy of the layers, weights included, without a compiled plan.
+    // Throws std::invalid_argument if a layer does not support Layer::clone.
+    std::unique_ptr<Network> clone() const;
+
+    // Freezes the current layers into an ExecutionPlan for batches of up to
+    // batch_size rows. predict() and train() use it from then on; adding a
+    // layer discards it. Throws std::invalid_argument on a shape mismatch.
+    void compile(int batch_size, int input_size = -1);
+    const ExecutionPlan* getPlan() const { return plan.get(); }
+
+    // Folds every BatchNorm that directly follows a Dense layer into that
+    // layer's weights and bias (using the running statistics) and removes
+    // it. Returns the number of layers folded.
+    int foldBatchNorm();
+
+    // Replaces every Dense layer with at least min_sparsity of its
+    // block_rows x block_cols tiles entirely zero by an equivalent
+    // BlockSparseDense. Returns the number of layers converted.
+    int convertToBlockSparse(int block_rows = 4, int block_cols = 8, double min_sparsity = 0.5);
+
+    // foldBatchNorm() followed by compile(): normalization costs nothing at
+    // inference time. Further training continues without the folded layers.
+    void compileForInference(int batch_size, int input_size = -1);
 };
 
 #endif // NETWORK_H
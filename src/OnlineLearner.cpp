@@ -0,0 +1,211 @@
+#include "OnlineLearner.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+// Holds one reader slot for the duration of a predict() or parameters()
+// call. Hazard stores and the re-check of `current` are sequentially
+// consistent so that, against the trainer's exchange and slot scan, either
+// the reader sees the new snapshot or the trainer sees the hazard.
+class OnlineLearner::Guard {
+public:
+    explicit Guard(ReaderSlot* slots) {
+        // Start at a per-thread position so concurrent readers rarely collide
+        size_t first = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (size_t k = 0;; ++k) {
+            ReaderSlot& candidate = slots[(first + k) % READER_SLOTS];
+            bool expected = false;
+            if (!candidate.busy.load(std::memory_order_relaxed) &&
+                candidate.busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                slot = &candidate;
+                return;
+            }
+            if ((k + 1) % READER_SLOTS == 0) std::this_thread::yield();
+        }
+    }
+
+    ~Guard() {
+        slot->hazard.store(nullptr, std::memory_order_release);
+        slot->busy.store(false, std::memory_order_release);
+    }
+
+    const Snapshot* protect(const std::atomic<const Snapshot*>& current) {
+        const Snapshot* snapshot = current.load(std::memory_order_seq_cst);
+        for (;;) {
+            slot->hazard.store(snapshot, std::memory_order_seq_cst);
+            const Snapshot* again = current.load(std::memory_order_seq_cst);
+            if (again == snapshot) return snapshot;
+            snapshot = again;
+        }
+    }
+
+private:
+    ReaderSlot* slot = nullptr;
+};
+
+OnlineLearner::OnlineLearner(const Builder& build, const std::vector<Matrix>& parameters, OnlineOptions options)
+    : options(options), queue(options.queue_capacity) {
+    if (options.batch_rows <= 0 || options.publish_every <= 0 || options.serve_batch_rows <= 0 ||
+        options.queue_capacity == 0) {
+        throw std::invalid_argument("OnlineLearner: batch sizes, publish interval and queue capacity must be positive");
+    }
+    build(trainer);
+    if (!parameters.empty()) {
+        std::vector<Matrix> own = trainer.saveParameters();
+        bool match = own.size() == parameters.size();
+        for (size_t p = 0; match && p < own.size(); ++p) {
+            match = own[p].rows == parameters[p].rows && own[p].cols == parameters[p].cols;
+        }
+        if (!match) {
+            throw std::invalid_argument("OnlineLearner: parameters do not match the built topology");
+        }
+        trainer.loadParameters(parameters);
+    }
+    trainer.compile(options.batch_rows);
+    input_size = trainer.getPlan()->inputSize();
+    output_size = trainer.getPlan()->outputSize();
+    x_batch = Matrix(options.batch_rows, input_size);
+    y_batch = Matrix(options.batch_rows, output_size);
+    publish();
+}
+
+OnlineLearner::~OnlineLearner() {
+    stop();
+    // No reader may outlive the learner, so nothing is protected any more
+    delete current.load();
+    for (const Snapshot* snapshot : retired) delete snapshot;
+}
+
+void OnlineLearner::start() {
+    if (worker.joinable()) return;
+    running.store(true, std::memory_order_release);
+    worker = std::thread(&OnlineLearner::run, this);
+}
+
+void OnlineLearner::stop() {
+    if (!worker.joinable()) return;
+    running.store(false, std::memory_order_release);
+    worker.join();
+}
+
+bool OnlineLearner::submit(const Matrix& x, const Matrix& y) {
+    if (x.rows <= 0 || x.rows != y.rows || x.cols != input_size || y.cols != output_size) {
+        throw std::invalid_argument("OnlineLearner: samples must be n x " + std::to_string(input_size) +
+                                    " inputs and n x " + std::to_string(output_size) + " targets");
+    }
+    Sample sample{x, y};
+    return queue.tryPush(sample);
+}
+
+Matrix OnlineLearner::predict(const Matrix& input, uint64_t* version) const {
+    if (input.cols != input_size) {
+        throw std::invalid_argument("OnlineLearner: input has " + std::to_string(input.cols) + " columns, expected " +
+                                    std::to_string(input_size));
+    }
+    Guard guard(slots);
+    const Snapshot* snapshot = guard.protect(current);
+    if (version) *version = snapshot->version;
+
+    const ExecutionPlan& plan = *snapshot->net->getPlan();
+    thread_local std::vector<double> arena;
+    if (arena.size() < plan.inferenceArenaSize()) arena.resize(plan.inferenceArenaSize());
+    Matrix output(input.rows, output_size);
+    for (int row0 = 0; row0 < input.rows; row0 += plan.batchSize()) {
+        int n = std::min(plan.batchSize(), input.rows - row0);
+        const double* result = plan.predictBlock(input, row0, n, arena.data());
+        kernels::unpackRows(result, n, output_size, output, row0);
+    }
+    return output;
+}
+
+std::vector<Matrix> OnlineLearner::parameters(uint64_t* version) const {
+    Guard guard(slots);
+    const Snapshot* snapshot = guard.protect(current);
+    if (version) *version = snapshot->version;
+    return snapshot->net->saveParameters();
+}
+
+void OnlineLearner::run() {
+    Sample sample;
+    for (;;) {
+        if (queue.tryPop(sample)) {
+            consume(sample);
+            continue;
+        }
+        if (!running.load(std::memory_order_acquire)) {
+            // Everything submitted before stop() is visible now
+            if (queue.tryPop(sample)) {
+                consume(sample);
+                continue;
+            }
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    if (batch_fill > 0) trainBatch(batch_fill);
+    if (steps_since_publish > 0) publish();
+}
+
+void OnlineLearner::consume(const Sample& sample) {
+    for (int i = 0; i < sample.x.rows; ++i) {
+        x_batch.data[batch_fill] = sample.x.data[i];
+        y_batch.data[batch_fill] = sample.y.data[i];
+        if (++batch_fill == options.batch_rows) trainBatch(batch_fill);
+    }
+    sample_count.fetch_add(sample.x.rows, std::memory_order_relaxed);
+}
+
+void OnlineLearner::trainBatch(int rows) {
+    if (rows == options.batch_rows) {
+        trainer.train(x_batch, y_batch, 1, options.learning_rate);
+    } else {
+        Matrix x(rows, input_size), y(rows, output_size);
+        for (int i = 0; i < rows; ++i) {
+            x.data[i] = x_batch.data[i];
+            y.data[i] = y_batch.data[i];
+        }
+        trainer.train(x, y, 1, options.learning_rate);
+    }
+    batch_fill = 0;
+    step_count.fetch_add(1, std::memory_order_relaxed);
+    if (++steps_since_publish >= options.publish_every) publish();
+}
+
+void OnlineLearner::publish() {
+    const Snapshot* previous = current.load(std::memory_order_relaxed);
+    const uint64_t version = previous ? previous->version + 1 : 0;
+    std::unique_ptr<Snapshot> snapshot(new Snapshot);
+    snapshot->version = version;
+    snapshot->net = trainer.clone();
+    snapshot->net->compileForInference(options.serve_batch_rows, input_size);
+    // Every snapshot has the same layers, so only the first one can fail
+    if (!snapshot->net->getPlan()->isReentrant()) {
+        throw std::invalid_argument("OnlineLearner: every layer must run through an inlined kernel to be served");
+    }
+    steps_since_publish = 0;
+
+    current.exchange(snapshot.release(), std::memory_order_seq_cst);
+    published.store(version, std::memory_order_release);
+    if (previous) retired.push_back(previous);
+    reclaim();
+}
+
+void OnlineLearner::reclaim() {
+    const Snapshot* in_use[READER_SLOTS];
+    for (int s = 0; s < READER_SLOTS; ++s) in_use[s] = slots[s].hazard.load(std::memory_order_seq_cst);
+
+    size_t kept = 0;
+    for (const Snapshot* snapshot : retired) {
+        bool protected_by_reader = false;
+        for (int s = 0; s < READER_SLOTS && !protected_by_reader; ++s) {
+            protected_by_reader = in_use[s] == snapshot;
+        }
+        if (protected_by_reader) {
+            retired[kept++] = snapshot;
+        } else {
+            delete snapshot;
+        }
+    }
+    retired.resize(kept);
+}
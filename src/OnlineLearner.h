@@ -0,0 +1,130 @@
+#ifndef ONLINE_LEARNER_H
+#define ONLINE_LEARNER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Network.h"
+#include "Parallel.h"
+
+struct OnlineOptions {
+    int batch_rows = 32;          // samples per SGD step
+    double learning_rate = 0.01;
+    int publish_every = 10;       // SGD steps between snapshots
+    size_t queue_capacity = 4096; // pending submit() calls
+    int serve_batch_rows = 256;   // rows per block in predict()
+};
+
+// Incremental training of a live model. A background thread takes samples
+// from a stream, trains a private Network on them options.batch_rows at a
+// time and, every options.publish_every steps, publishes an immutable
+// snapshot of the weights compiled for inference. predict() may be called
+// from any number of threads at any time and always runs on one whole
+// snapshot: publishing swaps a single atomic pointer, so serving never
+// waits for training and training never waits for serving.
+//
+// Old snapshots are reclaimed with hazard pointers. A reader claims one of
+// READER_SLOTS slots, announces the snapshot it is about to use there and
+// re-checks that it is still current; the trainer frees a retired snapshot
+// only once no slot announces it. Neither side takes a lock. With more
+// than READER_SLOTS concurrent predict() calls the extra callers spin until
+// a slot frees up.
+//
+// `build` runs once, in the constructor and on the calling thread, so any
+// Random streams it draws are taken there. Snapshots are Network::clone()
+// copies of the trained model compiled with Network::compileForInference,
+// so BatchNorm after Dense is folded away. Every remaining layer must run
+// through an inlined kernel (ExecutionPlan::isReentrant); the constructor
+// throws std::invalid_argument otherwise, e.g. for Dropout or Conv2D.
+class OnlineLearner {
+public:
+    using Builder = std::function<void(Network&)>;
+    static constexpr int READER_SLOTS = 64;
+
+    // Starts from `parameters` (Network::saveParameters() of a trained
+    // model) or, if empty, from the weights `build` initializes. Publishes
+    // that starting point as version 0; training begins with start().
+    OnlineLearner(const Builder& build, const std::vector<Matrix>& parameters = {},
+                  OnlineOptions options = OnlineOptions());
+    ~OnlineLearner();
+
+    OnlineLearner(const OnlineLearner&) = delete;
+    OnlineLearner& operator=(const OnlineLearner&) = delete;
+
+    void start();
+
+    // Call from the submitting thread. Trains on everything submitted so
+    // far, including a partial last batch, publishes the result if it
+    // changed and joins the trainer.
+    void stop();
+
+    // Queues the rows of (x, y) for training. Only one thread may submit.
+    // Returns false, dropping the samples, when the queue is full. Throws
+    // std::invalid_argument on a shape mismatch.
+    bool submit(const Matrix& x, const Matrix& y);
+
+    // Inference on the current snapshot, lock-free and safe to call
+    // concurrently with everything else. If `version` is given it receives
+    // the version of the snapshot used. Throws std::invalid_argument if
+    // input does not have inputSize() columns.
+    Matrix predict(const Matrix& input, uint64_t* version = nullptr) const;
+
+    // Parameters of the current snapshot as served, i.e. with BatchNorm
+    // folded, in Network::saveParameters() order.
+    std::vector<Matrix> parameters(uint64_t* version = nullptr) const;
+
+    uint64_t version() const { return published.load(std::memory_order_acquire); }
+    uint64_t steps() const { return step_count.load(std::memory_order_relaxed); }
+    uint64_t samplesSeen() const { return sample_count.load(std::memory_order_relaxed); }
+    int inputSize() const { return input_size; }
+    int outputSize() const { return output_size; }
+
+private:
+    struct Snapshot {
+        uint64_t version;
+        std::unique_ptr<Network> net;
+    };
+
+    struct Sample {
+        Matrix x, y;
+    };
+
+    struct alignas(64) ReaderSlot {
+        std::atomic<bool> busy{false};
+        std::atomic<const Snapshot*> hazard{nullptr};
+    };
+
+    // Marks a reader slot as announcing the live snapshot for its lifetime
+    class Guard;
+
+    OnlineOptions options;
+    int input_size = 0;
+    int output_size = 0;
+
+    Network trainer;                      // private copy, touched by the training thread only
+    Matrix x_batch, y_batch;
+    int batch_fill = 0;
+    int steps_since_publish = 0;
+
+    std::atomic<const Snapshot*> current{nullptr};
+    mutable ReaderSlot slots[READER_SLOTS];
+    std::vector<const Snapshot*> retired; // replaced, possibly still being read
+
+    parallel::SpscQueue<Sample> queue;
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> published{0};
+    std::atomic<uint64_t> step_count{0};
+    std::atomic<uint64_t> sample_count{0};
+
+    void run();
+    void consume(const Sample& sample);
+    void trainBatch(int rows);
+    void publish();
+    void reclaim();
+};
+
+#endif // ONLINE_LEARNER_H
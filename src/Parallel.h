@@ -0,0 +1,157 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+// Worker threads to use when the caller passes 0.
+inline int defaultThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : (int)n;
+}
+
+// Splits [0, n) into at most `threads` contiguous ranges of at least `grain`
+// items and calls f(begin, end) for each, the first on the calling thread.
+template <typename F>
+void forRanges(size_t n, size_t grain, int threads, F f) {
+    if (threads <= 0) threads = defaultThreads();
+    size_t chunks = std::min((size_t)threads, std::max<size_t>(1, n / std::max<size_t>(1, grain)));
+    if (chunks <= 1) {
+        f((size_t)0, n);
+        return;
+    }
+    size_t per = (n + chunks - 1) / chunks;
+    std::vector<std::thread> workers;
+    for (size_t c = 1; c < chunks; ++c) {
+        size_t begin = c * per;
+        size_t end = std::min(n, begin + per);
+        if (begin >= end) break;
+        workers.emplace_back(f, begin, end);
+    }
+    f((size_t)0, std::min(n, per));
+    for (std::thread& t : workers) t.join();
+}
+
+// Runs a fixed set of independent tasks on `threads` workers (0 = all
+// cores), the calling thread being one of them. Tasks are dealt round-robin
+// into one deque per worker. A worker runs its own deque from the back and,
+// once it is empty, steals from the front of the others, so tasks of very
+// different cost still keep every worker busy. Pass the tasks most expensive
+// first: owners start with those and thieves pick up the cheap tail.
+// Returns the number of steals. The first exception thrown by a task is
+// rethrown after all workers have finished.
+inline size_t runWorkStealing(std::vector<std::function<void()>>& tasks, int threads = 0) {
+    if (threads <= 0) threads = defaultThreads();
+    const size_t workers = std::max<size_t>(1, std::min(tasks.size(), (size_t)threads));
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>*> tasks;
+    };
+    std::vector<Queue> queues(workers);
+    for (size_t t = 0; t < tasks.size(); ++t) {
+        queues[t % workers].tasks.push_front(&tasks[t]);
+    }
+
+    std::atomic<size_t> steals{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto work = [&](size_t self) {
+        for (;;) {
+            std::function<void()>* task = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(queues[self].mutex);
+                if (!queues[self].tasks.empty()) {
+                    task = queues[self].tasks.back();
+                    queues[self].tasks.pop_back();
+                }
+            }
+            for (size_t k = 1; !task && k < workers; ++k) {
+                Queue& victim = queues[(self + k) % workers];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    steals++;
+                }
+            }
+            // No task is ever added after the start, so empty everywhere means done
+            if (!task) return;
+            try {
+                (*task)();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t w = 1; w < workers; ++w) pool.emplace_back(work, w);
+    work(0);
+    for (std::thread& t : pool) t.join();
+    if (error) std::rethrow_exception(error);
+    return steals;
+}
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Each side owns one index and only reads the other's, so a push or
+// pop is a relaxed load, an acquire load and a release store. The indices
+// sit on separate cache lines to keep the two threads from false sharing.
+// push() and pop() yield while the queue is full or empty.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    bool tryPush(T& value) {
+        size_t tail = tail_index.load(std::memory_order_relaxed);
+        if (tail - head_index.load(std::memory_order_acquire) == slots.size()) return false;
+        slots[tail & mask] = std::move(value);
+        tail_index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        size_t head = head_index.load(std::memory_order_relaxed);
+        if (head == tail_index.load(std::memory_order_acquire)) return false;
+        value = std::move(slots[head & mask]);
+        head_index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(T value) {
+        while (!tryPush(value)) std::this_thread::yield();
+    }
+
+    T pop() {
+        T value;
+        while (!tryPop(value)) std::this_thread::yield();
+        return value;
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head_index{0}; // next slot to read, written by the consumer
+    alignas(64) std::atomic<size_t> tail_index{0}; // next slot to write, written by the producer
+};
+
+} // namespace parallel
+
+#endif // PARALLEL_H
@@ -0,0 +1,334 @@
+#include "Pipeline.h"
+#include "Parallel.h"
+#include "layers/Normalization.h"
+#include "layers/Dropout.h"
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Thrown inside a stage that gives up because another stage failed
+struct Cancelled {};
+
+Matrix rowSlice(const Matrix& m, int row0, int n) {
+    Matrix out(n, m.cols);
+    for (int i = 0; i < n; ++i) out.data[i] = m.data[row0 + i];
+    return out;
+}
+
+} // namespace
+
+Pipeline::Pipeline(Network& net, int stage_count, int micro_batch_rows) : micro_rows(micro_batch_rows) {
+    const std::vector<Layer*>& layers = net.getLayers();
+    const int n = (int)layers.size();
+    if (stage_count <= 0 || stage_count > n) {
+        throw std::invalid_argument("Pipeline: need between 1 and " + std::to_string(n) + " stages");
+    }
+    if (micro_batch_rows <= 0) {
+        throw std::invalid_argument("Pipeline: micro-batch size must be positive");
+    }
+
+    // Shape check, and a per-row cost estimate for every layer: its
+    // parameters plus the activations it reads and writes
+    for (Layer* layer : layers) {
+        if (layer->inputSize() > 0) {
+            input_size = layer->inputSize();
+            break;
+        }
+    }
+    if (input_size <= 0) {
+        throw std::invalid_argument("Pipeline: cannot infer input width");
+    }
+    std::vector<double> prefix(n + 1, 0.0);
+    int width = input_size;
+    for (int i = 0; i < n; ++i) {
+        Layer* layer = layers[i];
+        int required = layer->inputSize();
+        if (required > 0 && required != width) {
+            throw std::invalid_argument("Pipeline: layer " + std::to_string(i) + " expects " +
+                                        std::to_string(required) + " inputs, got " + std::to_string(width));
+        }
+        int out = layer->outputSize(width);
+        double cost = width + out;
+        for (Matrix* p : layer->parameters()) cost += (double)p->rows * p->cols;
+        prefix[i + 1] = prefix[i] + cost;
+        width = out;
+        if (dynamic_cast<BatchNorm*>(layer) || dynamic_cast<Dropout*>(layer)) trainable = false;
+    }
+    output_size = width;
+
+    // Contiguous partition minimizing the most expensive stage:
+    // best[s][i] = cheapest bottleneck for layers [0, i) on s stages
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<std::vector<double>> best(stage_count + 1, std::vector<double>(n + 1, inf));
+    std::vector<std::vector<int>> split(stage_count + 1, std::vector<int>(n + 1, 0));
+    best[0][0] = 0.0;
+    for (int s = 1; s <= stage_count; ++s) {
+        for (int i = s; i <= n; ++i) {
+            for (int j = s - 1; j < i; ++j) {
+                double bottleneck = std::max(best[s - 1][j], prefix[i] - prefix[j]);
+                if (bottleneck < best[s][i]) {
+                    best[s][i] = bottleneck;
+                    split[s][i] = j;
+                }
+            }
+        }
+    }
+    first_layer.assign(stage_count + 1, n);
+    for (int s = stage_count, i = n; s > 0; --s) {
+        i = split[s][i];
+        first_layer[s - 1] = i;
+    }
+
+    stages.resize(stage_count);
+    for (int s = 0; s < stage_count; ++s) {
+        Stage& stage = stages[s];
+        for (int i = first_layer[s]; i < first_layer[s + 1]; ++i) {
+            stage.layers.push_back(layers[i]);
+            for (Matrix* p : layers[i]->parameters()) stage.params.push_back(p);
+        }
+    }
+    for (int s = 0; s + 1 < stage_count; ++s) {
+        forward_queues.emplace_back(new Queue(queue_capacity));
+        backward_queues.emplace_back(new Queue(queue_capacity));
+    }
+    for (int s = 1; s < stage_count; ++s) workers.emplace_back(&Pipeline::workerLoop, this, s);
+}
+
+Pipeline::~Pipeline() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shutting_down = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+}
+
+void Pipeline::workerLoop(int s) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return shutting_down || generation != seen; });
+            if (shutting_down) return;
+            seen = generation;
+        }
+        try {
+            job(s);
+        } catch (const Cancelled&) {
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+            cancelled.store(true);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) finished.notify_one();
+    }
+}
+
+void Pipeline::runStages(const std::function<void(int)>& run) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = run;
+        error = nullptr;
+        cancelled.store(false);
+        pending = stageCount() - 1;
+        ++generation;
+    }
+    wake.notify_all();
+
+    try {
+        run(0);
+    } catch (const Cancelled&) {
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) error = std::current_exception();
+        cancelled.store(true);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&]() { return pending == 0; });
+    if (error) std::rethrow_exception(error);
+}
+
+void Pipeline::prepareQueues(int micro) {
+    if ((size_t)micro > queue_capacity) {
+        queue_capacity = (size_t)micro;
+        for (size_t q = 0; q < forward_queues.size(); ++q) {
+            forward_queues[q].reset(new Queue(queue_capacity));
+            backward_queues[q].reset(new Queue(queue_capacity));
+        }
+        return;
+    }
+    // A cancelled call may have left micro-batches behind
+    Matrix leftover;
+    for (size_t q = 0; q < forward_queues.size(); ++q) {
+        while (forward_queues[q]->tryPop(leftover)) {}
+        while (backward_queues[q]->tryPop(leftover)) {}
+    }
+}
+
+Matrix Pipeline::receive(Queue& queue) {
+    Matrix value;
+    while (!queue.tryPop(value)) {
+        if (cancelled.load(std::memory_order_relaxed)) throw Cancelled();
+        std::this_thread::yield();
+    }
+    return value;
+}
+
+Matrix Pipeline::forwardStage(Stage& stage, Matrix x) {
+    for (Layer* layer : stage.layers) x = layer->forward(x);
+    return x;
+}
+
+Matrix Pipeline::backwardStage(Stage& stage, Matrix grad, double learning_rate) {
+    for (auto it = stage.layers.rbegin(); it != stage.layers.rend(); ++it) {
+        grad = (*it)->backward(grad, learning_rate);
+    }
+    // Move this micro-batch's update into the accumulator and restore the
+    // weights the step started from
+    for (size_t p = 0; p < stage.params.size(); ++p) {
+        Matrix& current = *stage.params[p];
+        const Matrix& start = stage.start[p];
+        Matrix& accum = stage.accum[p];
+        for (int i = 0; i < current.rows; ++i) {
+            for (int j = 0; j < current.cols; ++j) {
+                accum.data[i][j] += current.data[i][j] - start.data[i][j];
+                current.data[i][j] = start.data[i][j];
+            }
+        }
+    }
+    return grad;
+}
+
+Matrix Pipeline::predict(const Matrix& input) {
+    if (input.cols != input_size) {
+        throw std::invalid_argument("Pipeline: input has " + std::to_string(input.cols) + " columns, expected " +
+                                    std::to_string(input_size));
+    }
+    const int S = stageCount();
+    const int micro = (input.rows + micro_rows - 1) / micro_rows;
+    Matrix output(input.rows, output_size);
+    if (micro == 0) return output;
+    prepareQueues(micro);
+
+    runStages([&](int s) {
+        for (int m = 0; m < micro; ++m) {
+            const int row0 = m * micro_rows;
+            const int n = std::min(micro_rows, input.rows - row0);
+            Matrix x = s == 0 ? rowSlice(input, row0, n) : receive(*forward_queues[s - 1]);
+            x = forwardStage(stages[s], std::move(x));
+            if (s + 1 < S) {
+                forward_queues[s]->push(std::move(x));
+            } else {
+                for (int i = 0; i < n; ++i) output.data[row0 + i] = std::move(x.data[i]);
+            }
+        }
+    });
+    return output;
+}
+
+double Pipeline::trainStep(const Matrix& x, const Matrix& y, double learning_rate) {
+    if (!trainable) {
+        throw std::invalid_argument("Pipeline: BatchNorm and Dropout cannot be trained with recomputation");
+    }
+    if (x.cols != input_size || y.cols != output_size || x.rows != y.rows) {
+        throw std::invalid_argument("Pipeline: training data must be n x " + std::to_string(input_size) +
+                                    " inputs and n x " + std::to_string(output_size) + " targets");
+    }
+    const int S = stageCount();
+    const int micro = (x.rows + micro_rows - 1) / micro_rows;
+    if (micro == 0) return 0.0;
+    // d(mean squared error over the whole batch) / d(prediction)
+    const double scale = 2.0 / ((double)x.rows * output_size);
+
+    // Each queue holds a whole step's worth of micro-batches, so a stage
+    // still busy with forwards never blocks one that has started backwards
+    prepareQueues(micro);
+    std::vector<double> losses(micro, 0.0);
+
+    // Snapshots are taken before any stage starts, so a failed step can
+    // restore every stage
+    for (Stage& stage : stages) {
+        stage.start.resize(stage.params.size());
+        stage.accum.resize(stage.params.size());
+        for (size_t p = 0; p < stage.params.size(); ++p) {
+            stage.start[p] = *stage.params[p];
+            stage.accum[p] = Matrix(stage.start[p].rows, stage.start[p].cols);
+        }
+    }
+
+    auto run = [&](int s) {
+        Stage& stage = stages[s];
+        const bool last = (s + 1 == S);
+        std::vector<Matrix> inputs(last ? 0 : micro);
+        for (int m = 0; m < micro; ++m) {
+            const int row0 = m * micro_rows;
+            const int n = std::min(micro_rows, x.rows - row0);
+            Matrix in = s == 0 ? rowSlice(x, row0, n) : receive(*forward_queues[s - 1]);
+            if (!last) {
+                inputs[m] = in;
+                forward_queues[s]->push(forwardStage(stage, std::move(in)));
+                continue;
+            }
+
+            // The last stage turns each forward straight around: its layers
+            // still hold this micro-batch's state
+            Matrix out = forwardStage(stage, std::move(in));
+            Matrix grad(n, output_size);
+            double sum = 0.0;
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < output_size; ++j) {
+                    double diff = out.data[i][j] - y.data[row0 + i][j];
+                    sum += diff * diff;
+                    grad.data[i][j] = scale * diff;
+                }
+            }
+            losses[m] = sum;
+            grad = backwardStage(stage, std::move(grad), learning_rate);
+            if (s > 0) backward_queues[s - 1]->push(std::move(grad));
+        }
+
+        if (!last) {
+            for (int m = 0; m < micro; ++m) {
+                Matrix grad = receive(*backward_queues[s]);
+                forwardStage(stage, inputs[m]); // recompute this micro-batch's layer state
+                grad = backwardStage(stage, std::move(grad), learning_rate);
+                if (s > 0) backward_queues[s - 1]->push(std::move(grad));
+            }
+        }
+
+        for (size_t p = 0; p < stage.params.size(); ++p) {
+            *stage.params[p] = stage.start[p] + stage.accum[p];
+        }
+    };
+    try {
+        runStages(run);
+    } catch (...) {
+        for (Stage& stage : stages)
+            for (size_t p = 0; p < stage.params.size(); ++p) *stage.params[p] = stage.start[p];
+        throw;
+    }
+
+    double total = 0.0;
+    for (double l : losses) total += l;
+    return total / ((double)x.rows * output_size);
+}
+
+double Pipeline::train(const Matrix& x, const Matrix& y, int epochs, double learning_rate) {
+    for (Stage& stage : stages)
+        for (Layer* layer : stage.layers) layer->setTraining(true);
+    double loss = 0.0;
+    for (int e = 0; e < epochs; ++e) {
+        loss = trainStep(x, y, learning_rate);
+        if ((e + 1) % 100 == 0) {
+            std::cout << "Epoch " << (e + 1) << "/" << epochs << " error=" << loss << std::endl;
+        }
+    }
+    for (Stage& stage : stages)
+        for (Layer* layer : stage.layers) layer->setTraining(false);
+    return loss;
+}
@@ -0,0 +1,118 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Network.h"
+#include "Parallel.h"
+
+// Layer-wise pipeline parallelism. The network's layers are split into
+// `stages` contiguous ranges of roughly equal cost, each run by its own
+// thread. A batch is cut into micro-batches of micro_batch_rows rows that
+// stream from stage to stage through lock-free SPSC queues, so up to
+// `stages` micro-batches are being worked on at once.
+//
+// trainStep() follows GPipe: every micro-batch goes forward, then every
+// micro-batch goes backward. A stage keeps only the input of each
+// micro-batch and recomputes its layers' forward just before that
+// micro-batch's backward, so each layer's cached forward state is always the
+// right one. Layer::backward applies its own SGD step; the pipeline turns
+// that into gradient accumulation by restoring the weights the step started
+// from after every micro-batch and summing the changes, which are applied
+// together once all micro-batches are done. The result is one full-batch
+// step of Network::train, up to rounding.
+//
+// Recomputation requires a layer's training-mode forward to depend only on
+// its input and parameters, so trainStep() rejects BatchNorm (batch
+// statistics, running averages) and Dropout (a new mask per call) with
+// std::invalid_argument. predict() runs any layer.
+//
+// Stages 1..S-1 run on worker threads started by the constructor; each
+// predict() or trainStep() wakes them once and stage 0 runs on the calling
+// thread. An exception thrown by any stage cancels the others and is
+// rethrown to the caller; a failed trainStep() leaves the weights as they
+// were before it.
+//
+// The Pipeline drives the Network's layers directly; the Network must
+// outlive it and keep the same layers.
+class Pipeline {
+public:
+    // Throws std::invalid_argument on a shape mismatch or if there are more
+    // stages than layers.
+    Pipeline(Network& net, int stages, int micro_batch_rows);
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    int stageCount() const { return (int)stages.size(); }
+    int microBatchRows() const { return micro_rows; }
+
+    // First layer of each stage, followed by the number of layers
+    const std::vector<int>& boundaries() const { return first_layer; }
+
+    // Both throw std::invalid_argument on a shape mismatch. An input with
+    // no rows gives an empty prediction and a step that changes nothing.
+    Matrix predict(const Matrix& input);
+
+    // One GPipe step over all of (x, y). Returns the MSE before the update.
+    double trainStep(const Matrix& x, const Matrix& y, double learning_rate);
+
+    // Full-batch training like Network::train. Returns the last loss.
+    double train(const Matrix& x, const Matrix& y, int epochs, double learning_rate);
+
+private:
+    struct Stage {
+        std::vector<Layer*> layers;
+        std::vector<Matrix*> params;
+        std::vector<Matrix> start;  // parameters at the beginning of the step
+        std::vector<Matrix> accum;  // summed parameter changes of the step
+    };
+
+    using Queue = parallel::SpscQueue<Matrix>;
+
+    std::vector<Stage> stages;
+    std::vector<int> first_layer;
+    int micro_rows;
+    int input_size = -1;
+    int output_size = 0;
+    bool trainable = true;
+
+    // Between stage s and s + 1, kept across calls. Each holds a whole
+    // call's micro-batches, so a push never waits.
+    std::vector<std::unique_ptr<Queue>> forward_queues, backward_queues;
+    size_t queue_capacity = 1;
+
+    // Stage workers: a call bumps `generation` and waits for `pending` to
+    // drop to zero. Only this hand-off takes the mutex, once per call.
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, finished;
+    std::function<void(int)> job;
+    uint64_t generation = 0;
+    int pending = 0;
+    bool shutting_down = false;
+    std::exception_ptr error;
+    std::atomic<bool> cancelled{false};
+
+    Matrix forwardStage(Stage& stage, Matrix x);
+    Matrix backwardStage(Stage& stage, Matrix grad, double learning_rate);
+
+    // Queues with room for `micro` micro-batches and nothing left over
+    void prepareQueues(int micro);
+    // Pops from a queue, giving up once another stage has failed
+    Matrix receive(Queue& queue);
+
+    void workerLoop(int s);
+    // Runs run(s) for every stage, stage 0 on the calling thread, and
+    // rethrows the first exception any stage threw
+    void runStages(const std::function<void(int)>& run);
+};
+
+#endif // PIPELINE_H
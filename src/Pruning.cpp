@@ -0,0 +1,89 @@
+#include "Pruning.h"
+#include "layers/Dense.h"
+#include <algorithm>
+#include <stdexcept>
+
+BlockPruner::BlockPruner(Network& net, const PruningOptions& options) : options(options) {
+    if (options.block_rows <= 0 || options.block_cols <= 0 || options.sparsity < 0.0 || options.sparsity >= 1.0) {
+        throw std::invalid_argument("BlockPruner: invalid block shape or sparsity");
+    }
+    for (Layer* layer : net.getLayers()) {
+        if (Dense* dense = dynamic_cast<Dense*>(layer)) layers.push_back(dense);
+    }
+    if (!options.prune_output_layer && !layers.empty()) layers.pop_back();
+
+    for (Dense* dense : layers) {
+        int blocks_k = (dense->weights.rows + options.block_rows - 1) / options.block_rows;
+        int blocks_j = (dense->weights.cols + options.block_cols - 1) / options.block_cols;
+        masks.emplace_back((size_t)blocks_k * blocks_j, 0);
+    }
+}
+
+void BlockPruner::prune(double sparsity) {
+    const int br = options.block_rows, bc = options.block_cols;
+    for (size_t l = 0; l < layers.size(); ++l) {
+        const Matrix& W = layers[l]->weights;
+        const int blocks_j = (W.cols + bc - 1) / bc;
+        std::vector<uint8_t>& mask = masks[l];
+
+        // Squared L2 norm per tile; tiles already pruned sort first so the
+        // mask never shrinks
+        std::vector<double> norm(mask.size(), 0.0);
+        for (int k = 0; k < W.rows; ++k) {
+            for (int j = 0; j < W.cols; ++j) norm[(size_t)(k / br) * blocks_j + j / bc] += W.data[k][j] * W.data[k][j];
+        }
+        std::vector<int> order(mask.size());
+        for (size_t b = 0; b < order.size(); ++b) order[b] = (int)b;
+        size_t target = (size_t)(sparsity * mask.size());
+        if (target == 0) continue;
+        std::nth_element(order.begin(), order.begin() + (target - 1), order.end(), [&](int a, int b) {
+            if (mask[a] != mask[b]) return mask[a] > mask[b];
+            return norm[a] < norm[b];
+        });
+        for (size_t b = 0; b < target; ++b) mask[order[b]] = 1;
+    }
+    applyMasks();
+}
+
+void BlockPruner::applyMasks() {
+    const int br = options.block_rows, bc = options.block_cols;
+    for (size_t l = 0; l < layers.size(); ++l) {
+        Matrix& W = layers[l]->weights;
+        const int blocks_j = (W.cols + bc - 1) / bc;
+        const std::vector<uint8_t>& mask = masks[l];
+        for (int k = 0; k < W.rows; ++k) {
+            const uint8_t* row_mask = mask.data() + (size_t)(k / br) * blocks_j;
+            std::vector<double>& wk = W.data[k];
+            for (int j = 0; j < W.cols; ++j) {
+                if (row_mask[j / bc]) wk[j] = 0.0;
+            }
+        }
+    }
+}
+
+int BlockPruner::endEpoch(int epochs) const {
+    return std::max(options.start_epoch, options.end_epoch >= 0 ? options.end_epoch : epochs * 3 / 4);
+}
+
+double BlockPruner::scheduledSparsity(int epoch, int epochs) const {
+    const int end = endEpoch(epochs);
+    if (epoch < options.start_epoch) return 0.0;
+    if (epoch >= end) return options.sparsity;
+    double p = (double)(epoch - options.start_epoch) / (end - options.start_epoch);
+    return options.sparsity * (1.0 - (1.0 - p) * (1.0 - p) * (1.0 - p));
+}
+
+bool BlockPruner::prunesAt(int epoch, int epochs) const {
+    const int end = endEpoch(epochs);
+    if (epoch < options.start_epoch || epoch > end) return false;
+    return epoch == end || (epoch - options.start_epoch) % std::max(1, options.every) == 0;
+}
+
+double BlockPruner::sparsity() const {
+    size_t pruned = 0, total = 0;
+    for (const std::vector<uint8_t>& mask : masks) {
+        for (uint8_t m : mask) pruned += m;
+        total += mask.size();
+    }
+    return total ? (double)pruned / total : 0.0;
+}
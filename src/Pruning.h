@@ -0,0 +1,41 @@
+#ifndef PRUNING_H
+#define PRUNING_H
+
+#include <cstdint>
+#include <vector>
+#include "Network.h"
+
+class Dense;
+
+// Block magnitude pruning of a network's Dense layers. Each weight matrix is
+// cut into options.block_rows x options.block_cols tiles; prune(s) zeroes
+// the fraction s of tiles with the smallest L2 norm in every layer and
+// records them in a mask. Masks only grow: a pruned tile stays pruned, and
+// applyMasks() re-zeroes the tiles after every gradient step. The pruned
+// layers can then be turned into BlockSparseDense layers by
+// Network::convertToBlockSparse with the same tile shape.
+class BlockPruner {
+public:
+    BlockPruner(Network& net, const PruningOptions& options);
+
+    void prune(double sparsity);
+    void applyMasks();
+
+    // The gradual schedule of PruningOptions: the target for a 0-based epoch
+    // of a run of `epochs`, and whether that epoch re-prunes.
+    double scheduledSparsity(int epoch, int epochs) const;
+    bool prunesAt(int epoch, int epochs) const;
+
+    // First epoch at the full target sparsity; the masks do not change after it
+    int endEpoch(int epochs) const;
+
+    size_t layerCount() const { return layers.size(); }
+    double sparsity() const;  // pruned tiles / all tiles, over the pruned layers
+
+private:
+    PruningOptions options;
+    std::vector<Dense*> layers;
+    std::vector<std::vector<uint8_t>> masks; // per layer, 1 = tile pruned, [kb * block cols + jb]
+};
+
+#endif // PRUNING_H
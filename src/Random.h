@@ -0,0 +1,140 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Parallel.h"
+
+// Counter-based random numbers (Philox4x32-10, Salmon et al., SC'11).
+// Every value is a pure function of (seed, stream, index), so a fill can be
+// split across any number of threads or lanes and still produce the same
+// result, and a run is reproducible from its seed alone.
+namespace rng {
+
+struct Block {
+    uint32_t v[4];
+};
+
+inline Block philox4x32(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t k0, uint32_t k1) {
+    const uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    const uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = (uint64_t)M0 * c0;
+        uint64_t p1 = (uint64_t)M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n1 = (uint32_t)p1;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        uint32_t n3 = (uint32_t)p0;
+        c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+        k0 += W0;
+        k1 += W1;
+    }
+    return Block{{c0, c1, c2, c3}};
+}
+
+// Block number `index` of `stream` under `seed`
+inline Block block(uint64_t seed, uint64_t stream, uint64_t index) {
+    return philox4x32((uint32_t)index, (uint32_t)(index >> 32), (uint32_t)stream, (uint32_t)(stream >> 32),
+                      (uint32_t)seed, (uint32_t)(seed >> 32));
+}
+
+// 53-bit uniform in [0, 1)
+inline double toUnit(uint32_t hi, uint32_t lo) {
+    uint64_t x = ((uint64_t)hi << 32) | lo;
+    return (x >> 11) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace rng
+
+class Random {
+public:
+    // Sets the global seed and restarts stream numbering, so the same
+    // sequence of calls after seed(s) reproduces the same numbers.
+    static void seed(uint64_t s) {
+        globalSeed() = s;
+        streamCounter() = 0;
+    }
+
+    static uint64_t getSeed() { return globalSeed(); }
+
+    // A fresh stream id; each consumer (a weight matrix, a dropout layer, an
+    // epoch's shuffle) takes one so their numbers never overlap.
+    static uint64_t nextStream() { return streamCounter()++; }
+
+    // Fills out[0, count) with elements first .. first + count - 1 of the
+    // normal(mean, stddev) sequence of (seed, stream). Each Philox block gives
+    // two elements via Box-Muller. Blocks are generated in groups of LANES
+    // independent counters so the loop can be vectorized, and groups are
+    // spread over `threads` (0 = all cores). Output does not depend on either.
+    static void fillNormal(double* out, size_t count, uint64_t first, double mean, double stddev,
+                           uint64_t seed, uint64_t stream, int threads = 0) {
+        if (count == 0) return;
+        const uint64_t first_block = first / 2;
+        const uint64_t last_block = (first + count - 1) / 2;
+        const size_t blocks = (size_t)(last_block - first_block + 1);
+        parallel::forRanges(blocks, GRAIN, threads, [&](size_t b0, size_t b1) {
+            for (size_t g = b0; g < b1; g += LANES) {
+                size_t lanes = std::min((size_t)LANES, b1 - g);
+                rng::Block r[LANES];
+                for (size_t l = 0; l < lanes; ++l) r[l] = rng::block(seed, stream, first_block + g + l);
+                for (size_t l = 0; l < lanes; ++l) {
+                    double u1 = 1.0 - rng::toUnit(r[l].v[0], r[l].v[1]); // (0, 1]
+                    double u2 = rng::toUnit(r[l].v[2], r[l].v[3]);
+                    double radius = std::sqrt(-2.0 * std::log(u1));
+                    double angle = 6.283185307179586 * u2;
+                    uint64_t e = 2 * (first_block + g + l);
+                    if (e >= first && e < first + count) out[e - first] = mean + stddev * radius * std::cos(angle);
+                    if (e + 1 >= first && e + 1 < first + count) out[e + 1 - first] = mean + stddev * radius * std::sin(angle);
+                }
+            }
+        });
+    }
+
+    // Uniform in [low, high), one element per 64 bits of a block
+    static void fillUniform(double* out, size_t count, uint64_t first, double low, double high,
+                            uint64_t seed, uint64_t stream, int threads = 0) {
+        if (count == 0) return;
+        const uint64_t first_block = first / 2;
+        const size_t blocks = (size_t)((first + count - 1) / 2 - first_block + 1);
+        parallel::forRanges(blocks, GRAIN, threads, [&](size_t b0, size_t b1) {
+            for (size_t b = b0; b < b1; ++b) {
+                rng::Block r = rng::block(seed, stream, first_block + b);
+                uint64_t e = 2 * (first_block + b);
+                if (e >= first && e < first + count) out[e - first] = low + (high - low) * rng::toUnit(r.v[0], r.v[1]);
+                if (e + 1 >= first && e + 1 < first + count) out[e + 1 - first] = low + (high - low) * rng::toUnit(r.v[2], r.v[3]);
+            }
+        });
+    }
+
+    // Uniform integer in [0, bound) for element `index`
+    static uint32_t below(uint32_t bound, uint64_t seed, uint64_t stream, uint64_t index) {
+        rng::Block r = rng::block(seed, stream, index);
+        return (uint32_t)(((uint64_t)r.v[0] * bound) >> 32);
+    }
+
+    // Fisher-Yates permutation of `indices` drawn from (seed, stream)
+    static void shuffle(std::vector<int>& indices, uint64_t seed, uint64_t stream) {
+        for (size_t i = indices.size(); i-- > 1;) {
+            uint32_t j = below((uint32_t)(i + 1), seed, stream, i);
+            std::swap(indices[i], indices[j]);
+        }
+    }
+
+private:
+    static const size_t LANES = 8;
+    static const size_t GRAIN = 4096; // blocks per thread before splitting pays off
+
+    static uint64_t& globalSeed() {
+        static uint64_t s = 0x5EEDu;
+        return s;
+    }
+
+    static std::atomic<uint64_t>& streamCounter() {
+        static std::atomic<uint64_t> counter{0};
+        return counter;
+    }
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,224 @@
+#include "Sweep.h"
+#include "Parallel.h"
+#include "layers/Dense.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+const char* activationName(Activation::Kind kind) {
+    switch (kind) {
+        case Activation::Kind::Tanh: return "tanh";
+        case Activation::Kind::Sigmoid: return "sigmoid";
+        case Activation::Kind::Custom: return "custom";
+    }
+    return "?";
+}
+
+Layer* makeActivation(Activation::Kind kind) {
+    switch (kind) {
+        case Activation::Kind::Tanh: return new Tanh();
+        case Activation::Kind::Sigmoid: return new Sigmoid();
+        case Activation::Kind::Custom: break;
+    }
+    throw std::invalid_argument("HyperparameterSweep: only Tanh and Sigmoid can be searched");
+}
+
+std::string widths(const std::vector<int>& hidden) {
+    std::ostringstream os;
+    for (size_t i = 0; i < hidden.size(); ++i) os << (i ? "-" : "") << hidden[i];
+    return hidden.empty() ? "-" : os.str();
+}
+
+// Multiply-adds per training row, used to hand out the expensive trials first
+double cost(const SweepConfig& config, int in, int out) {
+    double total = 0.0;
+    int width = in;
+    for (int h : config.hidden) {
+        total += (double)width * h;
+        width = h;
+    }
+    return total + (double)width * out;
+}
+
+} // namespace
+
+std::string SweepConfig::describe() const {
+    std::ostringstream os;
+    os << widths(hidden) << " " << activationName(activation) << " lr=" << learning_rate << " epochs=" << epochs;
+    return os.str();
+}
+
+std::vector<SweepConfig> SearchSpace::grid() const {
+    std::vector<SweepConfig> configs;
+    for (const std::vector<int>& h : hidden)
+        for (Activation::Kind a : activations)
+            for (double lr : learning_rates)
+                for (int e : epochs)
+                    configs.push_back(SweepConfig{h, a, lr, e});
+    return configs;
+}
+
+std::vector<SweepConfig> SearchSpace::sample(int count, uint64_t seed) const {
+    if (hidden.empty() || activations.empty() || learning_rates.empty() || epochs.empty()) {
+        throw std::invalid_argument("SearchSpace: every dimension needs at least one value");
+    }
+    const double lo = std::log(*std::min_element(learning_rates.begin(), learning_rates.end()));
+    const double hi = std::log(*std::max_element(learning_rates.begin(), learning_rates.end()));
+
+    // Draw d of configuration i is element d of stream i
+    std::vector<SweepConfig> configs;
+    for (int i = 0; i < count; ++i) {
+        SweepConfig c;
+        c.hidden = hidden[Random::below((uint32_t)hidden.size(), seed, i, 0)];
+        c.activation = activations[Random::below((uint32_t)activations.size(), seed, i, 1)];
+        c.epochs = epochs[Random::below((uint32_t)epochs.size(), seed, i, 2)];
+        double u;
+        Random::fillUniform(&u, 1, 6, lo, hi, seed, i, 1);
+        c.learning_rate = std::exp(u);
+        configs.push_back(c);
+    }
+    return configs;
+}
+
+void SweepReport::print(std::ostream& os, size_t rows) const {
+    os << std::left << std::setw(5) << "#" << std::setw(7) << "trial" << std::setw(14) << "hidden"
+       << std::setw(9) << "act" << std::setw(11) << "lr" << std::setw(9) << "epochs"
+       << std::setw(13) << "train_loss" << std::setw(13) << "val_loss" << std::setw(9) << "status"
+       << "seconds" << "\n";
+    size_t shown = (rows == 0) ? results.size() : std::min(rows, results.size());
+    for (size_t r = 0; r < shown; ++r) {
+        const TrialResult& t = results[r];
+        std::ostringstream epochs;
+        epochs << t.epochs_run << "/" << t.config.epochs;
+        os << std::setw(5) << (r + 1) << std::setw(7) << t.trial << std::setw(14) << widths(t.config.hidden)
+           << std::setw(9) << activationName(t.config.activation) << std::setw(11) << t.config.learning_rate
+           << std::setw(9) << epochs.str() << std::setw(13) << t.train_loss << std::setw(13)
+           << t.validation_loss << std::setw(9) << (t.pruned ? "pruned" : "done") << t.seconds << "\n";
+    }
+    if (shown < results.size()) os << "... " << (results.size() - shown) << " more\n";
+    os << std::right;
+}
+
+HyperparameterSweep::HyperparameterSweep(const Matrix& x_train, const Matrix& y_train,
+                                         const Matrix& x_val, const Matrix& y_val, SweepOptions options)
+    : x_train(x_train), y_train(y_train), x_val(x_val), y_val(y_val), options(options) {
+    if (x_train.rows == 0 || x_val.rows == 0) {
+        throw std::invalid_argument("HyperparameterSweep: needs training and validation rows");
+    }
+    if (x_train.rows != y_train.rows || x_val.rows != y_val.rows || x_train.cols != x_val.cols ||
+        y_train.cols != y_val.cols) {
+        throw std::invalid_argument("HyperparameterSweep: dataset shapes do not match");
+    }
+}
+
+std::unique_ptr<Network> HyperparameterSweep::build(const SweepConfig& config, int trial) const {
+    std::unique_ptr<Network> net(new Network());
+    int width = x_train.cols;
+    for (int h : config.hidden) {
+        net->add(new Dense(width, h));
+        net->add(makeActivation(config.activation));
+        width = h;
+    }
+    net->add(new Dense(width, y_train.cols));
+    net->add(makeActivation(options.output_activation));
+
+    // The constructors drew from the global streams, whose order depends on
+    // thread timing; re-draw from the trial's own stream (one per layer).
+    uint64_t stream = 0;
+    for (Layer* layer : net->getLayers()) {
+        if (Dense* dense = dynamic_cast<Dense*>(layer)) {
+            dense->weights.setRandom(options.seed, ((uint64_t)trial << 16) + stream++, 1);
+        }
+    }
+    return net;
+}
+
+SweepReport HyperparameterSweep::run(const std::vector<SweepConfig>& configs) const {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+
+    SweepReport report;
+    std::vector<std::unique_ptr<Network>> nets(configs.size());
+    std::vector<TrialResult> results(configs.size());
+    std::vector<int> alive;
+    for (size_t t = 0; t < configs.size(); ++t) {
+        results[t].trial = (int)t;
+        results[t].config = configs[t];
+        if (configs[t].epochs > 0) alive.push_back((int)t);
+    }
+
+    while (!alive.empty()) {
+        // One rung: every live trial trains its next chunk of epochs
+        std::sort(alive.begin(), alive.end(), [&](int a, int b) {
+            double ca = cost(configs[a], x_train.cols, y_train.cols);
+            double cb = cost(configs[b], x_train.cols, y_train.cols);
+            return ca != cb ? ca > cb : a < b;
+        });
+        std::vector<std::function<void()>> tasks;
+        for (int t : alive) {
+            tasks.push_back([this, t, &configs, &nets, &results]() {
+                auto t0 = Clock::now();
+                const SweepConfig& config = configs[t];
+                TrialResult& result = results[t];
+                if (!nets[t]) nets[t] = build(config, t);
+
+                int chunk = config.epochs - result.epochs_run;
+                if (options.rung_epochs > 0) chunk = std::min(chunk, options.rung_epochs);
+                TrainingOptions fit_options;
+                fit_options.epochs = chunk;
+                fit_options.schedule = LearningRateSchedule::constant(config.learning_rate);
+                fit_options.validation_every = chunk;
+                fit_options.restore_best = false;
+                fit_options.verbose_every = 0;
+                TrainingHistory history = nets[t]->fit(x_train, y_train, x_val, y_val, fit_options);
+
+                result.epochs_run += chunk;
+                result.train_loss = history.train_loss.back();
+                result.validation_loss = history.validation_loss.back();
+                result.seconds += std::chrono::duration<double>(Clock::now() - t0).count();
+            });
+        }
+        report.steals += parallel::runWorkStealing(tasks, options.threads);
+
+        // Successive halving: rank the rung by validation loss, keep the top
+        // 1/eta; trials that reached their budget finish either way
+        std::vector<int> ranked = alive;
+        std::sort(ranked.begin(), ranked.end(), [&](int a, int b) {
+            double la = results[a].validation_loss, lb = results[b].validation_loss;
+            return la != lb ? la < lb : a < b;
+        });
+        size_t keep = ranked.size();
+        if (options.eta > 1) keep = std::max<size_t>(1, (ranked.size() + options.eta - 1) / options.eta);
+
+        alive.clear();
+        for (size_t r = 0; r < ranked.size(); ++r) {
+            int t = ranked[r];
+            if (results[t].epochs_run >= configs[t].epochs) {
+                nets[t].reset();
+            } else if (r < keep) {
+                alive.push_back(t);
+            } else {
+                results[t].pruned = true;
+                nets[t].reset();
+            }
+        }
+    }
+
+    // Finished trials first, then pruned ones by how far they got
+    std::sort(results.begin(), results.end(), [](const TrialResult& a, const TrialResult& b) {
+        if (a.pruned != b.pruned) return !a.pruned;
+        if (a.pruned && a.epochs_run != b.epochs_run) return a.epochs_run > b.epochs_run;
+        if (a.validation_loss != b.validation_loss) return a.validation_loss < b.validation_loss;
+        return a.trial < b.trial;
+    });
+    for (const TrialResult& r : results) report.trial_seconds += r.seconds;
+    report.results = std::move(results);
+    report.wall_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return report;
+}
@@ -0,0 +1,92 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Network.h"
+#include "layers/Activation.h"
+
+// One point of a hyperparameter search: the hidden-layer widths of a
+// Dense/activation stack, its activation, a constant learning rate and an
+// epoch budget.
+struct SweepConfig {
+    std::vector<int> hidden;
+    Activation::Kind activation = Activation::Kind::Tanh;
+    double learning_rate = 0.1;
+    int epochs = 100;
+
+    std::string describe() const;
+};
+
+// The values to search over. grid() is the full cartesian product;
+// sample() draws configurations at random, taking the learning rate
+// log-uniformly between the smallest and largest listed rate.
+struct SearchSpace {
+    std::vector<std::vector<int>> hidden = {{16}};
+    std::vector<Activation::Kind> activations = {Activation::Kind::Tanh};
+    std::vector<double> learning_rates = {0.1};
+    std::vector<int> epochs = {100};
+
+    std::vector<SweepConfig> grid() const;
+    std::vector<SweepConfig> sample(int count, uint64_t seed) const;
+};
+
+struct SweepOptions {
+    int threads = 0;            // 0 = all cores
+    uint64_t seed = 1;          // weights of trial t come from (seed, t)
+
+    // Successive halving: trials train rung_epochs at a time; after each
+    // rung only the best 1/eta of the trials that ran it (by validation
+    // loss) carry on. eta <= 1 trains every trial to its full budget.
+    int rung_epochs = 50;
+    int eta = 2;
+
+    Activation::Kind output_activation = Activation::Kind::Sigmoid;
+};
+
+struct TrialResult {
+    int trial = 0;              // index into the configuration list
+    SweepConfig config;
+    int epochs_run = 0;
+    bool pruned = false;        // stopped before its epoch budget
+    double train_loss = 0.0;
+    double validation_loss = 0.0;
+    double seconds = 0.0;       // time spent training this trial
+};
+
+struct SweepReport {
+    std::vector<TrialResult> results; // ranked, best first
+    double wall_seconds = 0.0;
+    double trial_seconds = 0.0;       // sum over trials
+    size_t steals = 0;                // tasks taken from another worker
+
+    void print(std::ostream& os, size_t rows = 0) const;
+};
+
+// Trains many small networks concurrently. Every trial reads the same
+// training and validation matrices (never copied) and owns its Network;
+// each rung is a batch of independent tasks run by
+// parallel::runWorkStealing. Trials are initialized from their own seed
+// and train full-batch, so the report does not depend on the thread count.
+class HyperparameterSweep {
+public:
+    HyperparameterSweep(const Matrix& x_train, const Matrix& y_train,
+                        const Matrix& x_val, const Matrix& y_val, SweepOptions options = SweepOptions());
+
+    SweepReport run(const std::vector<SweepConfig>& configs) const;
+
+    // The network a trial trains, initialized from (options.seed, trial)
+    std::unique_ptr<Network> build(const SweepConfig& config, int trial) const;
+
+private:
+    const Matrix& x_train;
+    const Matrix& y_train;
+    const Matrix& x_val;
+    const Matrix& y_val;
+    SweepOptions options;
+};
+
+#endif // SWEEP_H
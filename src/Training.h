@@ -0,0 +1,137 @@
+#ifndef TRAINING_H
+#define TRAINING_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Learning-rate schedules for Network::fit. rate(epoch) gives the rate for a
+// 0-based epoch; observe() feeds each validation loss to the plateau schedule.
+class LearningRateSchedule {
+public:
+    enum class Kind { Constant, Step, Cosine, Plateau };
+
+    static LearningRateSchedule constant(double rate) {
+        return LearningRateSchedule(Kind::Constant, rate);
+    }
+
+    // rate * gamma^(epoch / every)
+    static LearningRateSchedule step(double rate, int every, double gamma) {
+        LearningRateSchedule s(Kind::Step, rate);
+        s.every = every;
+        s.factor = gamma;
+        return s;
+    }
+
+    // Half-cosine from rate down to min_rate over total_epochs
+    static LearningRateSchedule cosine(double rate, int total_epochs, double min_rate = 0.0) {
+        LearningRateSchedule s(Kind::Cosine, rate);
+        s.every = total_epochs;
+        s.min_rate = min_rate;
+        return s;
+    }
+
+    // Multiplies the rate by factor after `patience` validation checks
+    // without improvement
+    static LearningRateSchedule plateau(double rate, double factor = 0.5, int patience = 5,
+                                        double min_rate = 1e-6) {
+        LearningRateSchedule s(Kind::Plateau, rate);
+        s.factor = factor;
+        s.every = patience;
+        s.min_rate = min_rate;
+        return s;
+    }
+
+    double rate(int epoch) const {
+        switch (kind) {
+            case Kind::Constant: return base;
+            case Kind::Step: return base * std::pow(factor, epoch / every);
+            case Kind::Cosine: {
+                double t = std::min(1.0, (double)epoch / every);
+                return min_rate + 0.5 * (base - min_rate) * (1 + std::cos(3.14159265358979323846 * t));
+            }
+            case Kind::Plateau: return current;
+        }
+        return base;
+    }
+
+    void observe(double validation_loss) {
+        if (kind != Kind::Plateau) return;
+        if (validation_loss < best) {
+            best = validation_loss;
+            wait = 0;
+        } else if (++wait >= every) {
+            current = std::max(min_rate, current * factor);
+            wait = 0;
+        }
+    }
+
+    Kind getKind() const { return kind; }
+
+private:
+    Kind kind;
+    double base;
+    double factor = 1.0;
+    int every = 1;
+    double min_rate = 0.0;
+    double current;
+    double best = HUGE_VAL;
+    int wait = 0;
+
+    LearningRateSchedule(Kind kind, double rate) : kind(kind), base(rate), current(rate) {}
+};
+
+// Magnitude pruning of Dense weights in block_rows x block_cols tiles (see
+// BlockPruner). In fit(), the target sparsity is reached gradually: from
+// start_epoch to end_epoch the fraction of pruned tiles in each layer
+// follows sparsity * (1 - (1 - p)^3), p the progress through the ramp,
+// updated every `every` epochs; afterwards the masks stay fixed while
+// training fine-tunes the remaining weights.
+struct PruningOptions {
+    double sparsity = 0.0;            // 0 disables pruning
+    int block_rows = 4;               // tile shape in W (inputs x outputs)
+    int block_cols = 8;
+    bool prune_output_layer = false;  // the last Dense layer is small and sensitive
+    int start_epoch = 0;
+    int end_epoch = -1;               // -1: three quarters of TrainingOptions::epochs
+    int every = 1;
+};
+
+struct TrainingOptions {
+    int epochs = 1000;
+    LearningRateSchedule schedule = LearningRateSchedule::constant(0.01);
+
+    // Rows per gradient step (0 = the whole training set). With mini-batches
+    // the rows are reshuffled every epoch from the global Random seed.
+    int batch_size = 0;
+    bool shuffle = true;
+
+    // Fraction of rows (taken from the end) held out for validation when no
+    // explicit validation set is passed to fit().
+    double validation_split = 0.0;
+    int validation_every = 10;   // epochs between validation passes
+    int validation_batch = 256;  // rows per forward pass during validation
+
+    // Stop after `patience` validation passes without an improvement larger
+    // than min_delta (0 disables early stopping). With pruning, neither the
+    // best checkpoint nor patience counts before the pruning end epoch.
+    int patience = 0;
+    double min_delta = 0.0;
+    bool restore_best = true;
+
+    int verbose_every = 100;     // 0 silences progress output
+
+    PruningOptions pruning;
+};
+
+struct TrainingHistory {
+    int epochs_run = 0;
+    bool stopped_early = false;
+    int best_epoch = -1;                  // 1-based epoch of the best validation loss
+    double best_validation_loss = HUGE_VAL;
+    std::vector<double> train_loss;       // one per epoch
+    std::vector<double> validation_loss;  // one per validation pass
+    double sparsity = 0.0;                // pruned tiles / all tiles at the end (pruning only)
+};
+
+#endif // TRAINING_H
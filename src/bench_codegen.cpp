@@ -0,0 +1,71 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "ModelZoo.h"
+#include "xor_net.h"
+#include "large_net.h"
+
+// Benchmark: one prediction at a time through the layer-by-layer
+// interpreter, the compiled ExecutionPlan and the header generated at build
+// time by codegen_models (see CMakeLists.txt).
+
+template <typename F>
+static double nsPerCall(int calls, F f) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < calls; ++i) f(i);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+}
+
+template <typename Predict>
+static void run(const char* name, Network& net, const Matrix& X, int calls, Predict generated) {
+    const int n = X.rows;
+    std::vector<Matrix> rows(n, Matrix(1, X.cols));
+    for (int i = 0; i < n; ++i) rows[i].data[0] = X.data[i];
+
+    // Same numbers from all three paths
+    double max_diff = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double out[1];
+        generated(X.data[i].data(), out);
+        max_diff = std::max(max_diff, std::abs(out[0] - net.predict(rows[i]).data[0][0]));
+    }
+
+    double sink = 0.0;
+    double interp = nsPerCall(calls, [&](int i) { sink += net.predict(rows[i % n]).data[0][0]; });
+    net.compile(1);
+    double planned = nsPerCall(calls, [&](int i) { sink += net.predict(rows[i % n]).data[0][0]; });
+    double aot = nsPerCall(calls, [&](int i) {
+        double out[1];
+        generated(X.data[i % n].data(), out);
+        sink += out[0];
+    });
+
+    std::cout << name << "\n"
+              << "  Intérprete:      " << interp << " ns/predicción\n"
+              << "  Plan compilado:  " << planned << " ns/predicción\n"
+              << "  Código generado: " << aot << " ns/predicción (" << interp / aot << "x)\n"
+              << "  Diferencia máxima: " << max_diff << "  (checksum " << sink << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Benchmark: código generado vs intérprete (una muestra por llamada) ===" << std::endl
+              << std::endl;
+
+    Network xor_model;
+    models::buildXor(xor_model);
+    Matrix X(4, 2);
+    X.data = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    run("XOR 2 -> 3 -> 1", xor_model, X, 400000,
+        [](const double* in, double* out) { xor_net::predict(in, out); });
+
+    Network large_model;
+    models::buildLarge(large_model);
+    Matrix XL, YL;
+    models::makeLargeDataset(256, XL, YL);
+    run("10 -> 50 -> 30 -> 10 -> 1 (BatchNorm)", large_model, XL, 40000,
+        [](const double* in, double* out) { large_net::predict(in, out); });
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include "Network.h"
+#include "layers/Dense.h"
+#include "layers/Activation.h"
+#include "layers/Conv2D.h"
+#include "layers/Pooling.h"
+
+// Benchmark: convolutional network vs. an equivalent Dense network on small
+// synthetic images (12x12, one channel). Class 1 images contain a horizontal
+// bar, class 0 images a vertical bar, both at a random position with noise.
+
+const int SIDE = 12;
+
+static void makeDataset(int n, std::mt19937& gen, Layout layout, Matrix& X, Matrix& Y) {
+    std::uniform_int_distribution<> pos(0, SIDE - 1);
+    std::uniform_int_distribution<> start(0, SIDE - 6);
+    std::normal_distribution<> noise(0.0, 0.1);
+    Shape3 shape{1, SIDE, SIDE};
+    X = Matrix(n, shape.size());
+    Y = Matrix(n, 1);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < shape.size(); ++j) X.data[i][j] = noise(gen);
+        bool horizontal = (i % 2 == 0);
+        int line = pos(gen), s = start(gen);
+        for (int k = s; k < s + 6; ++k) {
+            int h = horizontal ? line : k;
+            int w = horizontal ? k : line;
+            X.data[i][shape.index(layout, 0, h, w)] += 1.0;
+        }
+        Y.data[i][0] = horizontal ? 1.0 : 0.0;
+    }
+}
+
+static double accuracy(Network& net, const Matrix& X, const Matrix& Y) {
+    Matrix p = net.predict(X);
+    int correct = 0;
+    for (int i = 0; i < X.rows; ++i) {
+        if ((p.data[i][0] >= 0.5) == (Y.data[i][0] >= 0.5)) correct++;
+    }
+    return 100.0 * correct / X.rows;
+}
+
+static void run(const char* name, Network& net, long params, const Matrix& X, const Matrix& Y,
+                const Matrix& X_test, const Matrix& Y_test, int epochs) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    net.train(X, Y, epochs, 0.5);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    Matrix p = net.predict(X_test);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    double train_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double infer_ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    std::cout << name << "\n"
+              << "  Parámetros: " << params << "\n"
+              << "  Entrenamiento: " << train_ms / epochs << " ms/época\n"
+              << "  Inferencia: " << infer_ms * 1000.0 / X_test.rows << " us/muestra\n"
+              << "  Precisión (test): " << accuracy(net, X_test, Y_test) << "%" << std::endl;
+}
+
+int main() {
+    const int train_samples = 200;
+    const int test_samples = 200;
+    const int epochs = 300;
+
+    std::cout << "=== Benchmark: Conv2D + MaxPool vs Dense ===" << std::endl;
+    std::cout << "Imágenes " << SIDE << "x" << SIDE << ", " << train_samples << " de entrenamiento, "
+              << test_samples << " de prueba, " << epochs << " épocas" << std::endl << std::endl;
+
+    for (Layout layout : {Layout::NCHW, Layout::NHWC}) {
+        std::mt19937 gen(42);
+        Matrix X, Y, X_test, Y_test;
+        makeDataset(train_samples, gen, layout, X, Y);
+        makeDataset(test_samples, gen, layout, X_test, Y_test);
+
+        // 1x12x12 -> Conv 3x3 (4 filtros) -> 4x10x10 -> MaxPool 2x2 -> 4x5x5 -> 1
+        Network conv;
+        conv.add(new Conv2D(1, SIDE, SIDE, 4, 3, 3, 1, 0, layout));
+        conv.add(new Tanh());
+        conv.add(new MaxPool(4, 10, 10, 2, 2, 0, layout));
+        conv.add(new Dense(100, 1));
+        conv.add(new Sigmoid());
+        long conv_params = (9 * 4 + 4) + (100 + 1);
+
+        run(layout == Layout::NCHW ? "Conv2D (NCHW)" : "Conv2D (NHWC)",
+            conv, conv_params, X, Y, X_test, Y_test, epochs);
+
+        if (layout == Layout::NCHW) {
+            // Same input and same hidden width (100) as the conv net
+            Network dense;
+            dense.add(new Dense(SIDE * SIDE, 100));
+            dense.add(new Tanh());
+            dense.add(new Dense(100, 1));
+            dense.add(new Sigmoid());
+            long dense_params = (SIDE * SIDE * 100 + 100) + (100 + 1);
+
+            run("Dense", dense, dense_params, X, Y, X_test, Y_test, epochs);
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "Ensemble.h"
+#include "ModelZoo.h"
+
+// Benchmark: an ensemble of 10 -> 50 -> 30 -> 10 -> 1 networks (the
+// main_large.cpp shape) evaluated by calling predict() on every member in
+// turn versus one grouped pass through Ensemble::predict.
+
+static Network* makeMember() {
+    Network* net = new Network();
+    net->add(new Dense(10, 50));
+    net->add(new Tanh());
+    net->add(new Dense(50, 30));
+    net->add(new Tanh());
+    net->add(new Dense(30, 10));
+    net->add(new Tanh());
+    net->add(new Dense(10, 1));
+    net->add(new Sigmoid());
+    return net;
+}
+
+template <typename F>
+static double msPerCall(int calls, F f) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < calls; ++i) f();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count() / calls;
+}
+
+static void run(int rows) {
+    Matrix X, Y;
+    models::makeLargeDataset(rows, X, Y);
+
+    std::cout << "Lote de " << rows << (rows == 1 ? " fila" : " filas") << ", una hebra" << std::endl;
+    std::cout << "miembros  secuencial(ms)  plan(ms)  agrupado(ms)  aceleración  dif. máx." << std::endl;
+
+    Random::seed(3);
+    for (int size : {1, 4, 16, 64}) {
+        Ensemble ensemble;
+        for (int m = 0; m < size; ++m) ensemble.add(makeMember());
+        int calls = std::max(2, 32768 / (size * rows));
+
+        // Baseline: mean of each member's predict()
+        Matrix sequential_mean;
+        double sequential = msPerCall(calls, [&]() {
+            sequential_mean = Matrix(rows, 1);
+            for (size_t m = 0; m < ensemble.size(); ++m) {
+                Matrix p = ensemble.member(m).predict(X);
+                for (int i = 0; i < rows; ++i) sequential_mean.data[i][0] += p.data[i][0];
+            }
+            for (int i = 0; i < rows; ++i) sequential_mean.data[i][0] /= size;
+        });
+
+        // Same with every member compiled to an ExecutionPlan
+        for (size_t m = 0; m < ensemble.size(); ++m) ensemble.member(m).compile(rows);
+        double planned = msPerCall(calls, [&]() {
+            for (size_t m = 0; m < ensemble.size(); ++m) ensemble.member(m).predict(X);
+        });
+
+        Matrix grouped_mean;
+        ensemble.pack();
+        double grouped = msPerCall(calls, [&]() { grouped_mean = ensemble.predict(X, EnsembleReduction::Mean, 1); });
+
+        double max_diff = 0.0;
+        for (int i = 0; i < rows; ++i) {
+            max_diff = std::max(max_diff, std::abs(grouped_mean.data[i][0] - sequential_mean.data[i][0]));
+        }
+        std::cout << size << "\t  " << sequential << "\t  " << planned << "\t    " << grouped << "\t  "
+                  << sequential / grouped << "x\t       " << max_diff << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main() {
+    std::cout << "=== Benchmark: ensemble agrupado vs predict() secuencial ===" << std::endl << std::endl;
+    run(1);   // serving one request: per-call overhead dominates
+    run(256); // batch: arithmetic dominates
+    return 0;
+}
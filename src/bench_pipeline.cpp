@@ -0,0 +1,69 @@
+#include <iostream>
+#include <chrono>
+#include "Pipeline.h"
+#include "Parallel.h"
+#include "layers/Dense.h"
+#include "layers/Activation.h"
+
+// Benchmark: a deep stack of equal Dense + Tanh blocks run layer by layer
+// (Network::predict / Network::train) versus a Pipeline with 1, 2, 4 and 8
+// stages. Throughput is in rows per second; gains need at least as many
+// cores as stages.
+
+namespace {
+
+const int INPUT = 64;
+const int WIDTH = 128;
+const int BLOCKS = 8;
+const int BATCH = 512;
+const int MICRO = 32;
+
+void buildNetwork(Network& net) {
+    Random::seed(4);
+    net.add(new Dense(INPUT, WIDTH));
+    net.add(new Tanh());
+    for (int b = 1; b < BLOCKS; ++b) {
+        net.add(new Dense(WIDTH, WIDTH));
+        net.add(new Tanh());
+    }
+    net.add(new Dense(WIDTH, 1));
+    net.add(new Sigmoid());
+}
+
+template <typename F>
+double secondsPerCall(int calls, F f) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < calls; ++i) f();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count() / calls;
+}
+
+} // namespace
+
+int main() {
+    Matrix X(BATCH, INPUT), Y(BATCH, 1);
+    X.setRandom(9, 0);
+    for (int i = 0; i < BATCH; ++i) Y.data[i][0] = X.data[i][0] > 0 ? 1.0 : 0.0;
+
+    std::cout << "=== Benchmark: paralelismo de pipeline por capas ===" << std::endl;
+    std::cout << BLOCKS << " bloques Dense(" << WIDTH << ") + Tanh, lote " << BATCH << ", micro-lotes de " << MICRO
+              << " filas, " << parallel::defaultThreads() << " hilos disponibles" << std::endl << std::endl;
+
+    Network net;
+    buildNetwork(net);
+    const int calls = 3;
+    double base_predict = secondsPerCall(calls, [&]() { net.predict(X); });
+    double base_train = secondsPerCall(calls, [&]() { net.train(X, Y, 1, 0.01); });
+
+    std::cout << "etapas  inferencia(filas/s)  aceleración  entrenamiento(filas/s)  aceleración" << std::endl;
+    std::cout << "capas\t" << BATCH / base_predict << "\t\t     1x\t\t  " << BATCH / base_train << "\t\t  1x"
+              << "   (Network, secuencial)" << std::endl;
+    for (int stages : {1, 2, 4, 8}) {
+        Pipeline pipeline(net, stages, MICRO);
+        double predict = secondsPerCall(calls, [&]() { pipeline.predict(X); });
+        double train = secondsPerCall(calls, [&]() { pipeline.trainStep(X, Y, 0.01); });
+        std::cout << stages << "\t" << BATCH / predict << "\t\t     " << base_predict / predict << "x\t  "
+                  << BATCH / train << "\t\t  " << base_train / train << "x" << std::endl;
+    }
+    return 0;
+}
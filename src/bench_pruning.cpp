@@ -0,0 +1,100 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "ModelZoo.h"
+#include "Pruning.h"
+#include "layers/BlockSparseDense.h"
+
+// Report: the main_large.cpp network trained with gradual block pruning at
+// several target sparsities. For each, accuracy on held-out rows and the
+// inference time of the compiled plan with the pruned weights kept dense
+// versus converted to BlockSparseDense.
+
+namespace {
+
+const int TRAIN_ROWS = 1000;
+const int TEST_ROWS = 5000;
+const int BATCH = 256;
+
+template <typename F>
+double msPerCall(int calls, F f) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < calls; ++i) f();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count() / calls;
+}
+
+void buildNetwork(Network& net) {
+    net.add(new Dense(10, 50));
+    net.add(new BatchNorm(50));
+    net.add(new Tanh());
+    net.add(new Dense(50, 30));
+    net.add(new BatchNorm(30));
+    net.add(new Tanh());
+    net.add(new Dense(30, 10));
+    net.add(new BatchNorm(10));
+    net.add(new Tanh());
+    net.add(new Dense(10, 1));
+    net.add(new Sigmoid());
+}
+
+} // namespace
+
+int main() {
+    Matrix X, Y;
+    models::makeLargeDataset(TRAIN_ROWS + TEST_ROWS, X, Y);
+    Matrix X_train(TRAIN_ROWS, X.cols), Y_train(TRAIN_ROWS, 1);
+    Matrix X_test(TEST_ROWS, X.cols), Y_test(TEST_ROWS, 1);
+    for (int i = 0; i < X.rows; ++i) {
+        if (i < TRAIN_ROWS) {
+            X_train.data[i] = X.data[i];
+            Y_train.data[i] = Y.data[i];
+        } else {
+            X_test.data[i - TRAIN_ROWS] = X.data[i];
+            Y_test.data[i - TRAIN_ROWS] = Y.data[i];
+        }
+    }
+
+    std::cout << "=== Poda por bloques: aceleración vs dispersión vs exactitud ===" << std::endl;
+    std::cout << "Tarea de main_large.cpp, " << TRAIN_ROWS << " filas de entrenamiento, " << TEST_ROWS
+              << " de prueba; bloques 4x8, capa de salida sin podar" << std::endl << std::endl;
+    std::cout << "dispersión  exactitud  densa(ms)  dispersa(ms)  aceleración  capas convertidas" << std::endl;
+
+    EvaluationOptions evaluation;
+    evaluation.threads = 1;
+    for (double sparsity : {0.0, 0.5, 0.75, 0.9}) {
+        Random::seed(2);
+        Network net;
+        buildNetwork(net);
+
+        TrainingOptions options;
+        options.epochs = 400;
+        options.schedule = LearningRateSchedule::constant(0.1);
+        options.verbose_every = 0;
+        options.pruning.sparsity = sparsity;
+        net.compile(TRAIN_ROWS);
+        net.fit(X_train, Y_train, options);
+        net.foldBatchNorm();
+
+        // Same weights, first through the dense kernels, then block-sparse
+        net.compile(BATCH);
+        Matrix dense_out;
+        double dense = msPerCall(20, [&]() { dense_out = net.predict(X_test); });
+        double accuracy = net.evaluate(X_test, Y_test, evaluation).accuracy();
+
+        int converted = net.convertToBlockSparse(4, 8, 0.25);
+        net.compile(BATCH);
+        Matrix sparse_out;
+        double sparse = msPerCall(20, [&]() { sparse_out = net.predict(X_test); });
+        for (int i = 0; i < TEST_ROWS; ++i) {
+            if (sparse_out.data[i][0] != dense_out.data[i][0]) {
+                std::cout << "¡Las predicciones dispersas difieren en la fila " << i << "!" << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << sparsity * 100 << "%\t    " << accuracy * 100 << "%\t   " << dense << "\t      " << sparse
+                  << "\t    " << dense / sparse << "x\t " << converted << std::endl;
+    }
+    return 0;
+}
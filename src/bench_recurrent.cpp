@@ -0,0 +1,228 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "layers/Recurrent.h"
+
+// Benchmark: the fused LSTM/GRU layers against a straightforward per-gate
+// implementation that keeps one weight matrix per gate and calls
+// Matrix::multiply for every gate at every timestep. Both start from the
+// same weights, so the outputs must agree.
+
+namespace {
+
+double sigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+
+Matrix columns(const Matrix& m, int first, int count) {
+    Matrix out(m.rows, count);
+    for (int i = 0; i < m.rows; ++i)
+        for (int j = 0; j < count; ++j) out.data[i][j] = m.data[i][first + j];
+    return out;
+}
+
+Matrix timestep(const Matrix& x, int t, int features) {
+    return columns(x, t * features, features);
+}
+
+Matrix addBias(Matrix m, const Matrix& bias) {
+    for (int i = 0; i < m.rows; ++i)
+        for (int j = 0; j < m.cols; ++j) m.data[i][j] += bias.data[0][j];
+    return m;
+}
+
+Matrix apply(Matrix m, double (*f)(double)) {
+    for (auto& row : m.data)
+        for (double& v : row) v = f(v);
+    return m;
+}
+
+double tanhFn(double x) { return std::tanh(x); }
+
+Matrix oneMinus(const Matrix& m) {
+    Matrix out(m.rows, m.cols);
+    for (int i = 0; i < m.rows; ++i)
+        for (int j = 0; j < m.cols; ++j) out.data[i][j] = 1.0 - m.data[i][j];
+    return out;
+}
+
+Matrix columnSums(const Matrix& m) {
+    Matrix out(1, m.cols);
+    for (int i = 0; i < m.rows; ++i)
+        for (int j = 0; j < m.cols; ++j) out.data[0][j] += m.data[i][j];
+    return out;
+}
+
+// One weight matrix per gate, one Matrix::multiply per gate and step
+struct NaiveLSTM {
+    int features, steps, hidden;
+    Matrix Wg[4], Ug[4], bg[4];
+
+    // Per-step state kept for backpropagation
+    std::vector<Matrix> xs, hs, cs, gate_values[4];
+
+    explicit NaiveLSTM(const LSTM& fused, int features)
+        : features(features), steps(fused.sequenceLength()), hidden(fused.hiddenSize()) {
+        for (int g = 0; g < 4; ++g) {
+            Wg[g] = columns(fused.W, g * hidden, hidden);
+            Ug[g] = columns(fused.U, g * hidden, hidden);
+            bg[g] = columns(fused.bias, g * hidden, hidden);
+        }
+    }
+
+    Matrix forward(const Matrix& x) {
+        xs.clear();
+        hs.assign(1, Matrix(x.rows, hidden));
+        cs.assign(1, Matrix(x.rows, hidden));
+        for (auto& v : gate_values) v.clear();
+        for (int t = 0; t < steps; ++t) {
+            Matrix xt = timestep(x, t, features);
+            Matrix pre[4];
+            for (int g = 0; g < 4; ++g) {
+                pre[g] = addBias(Matrix::multiply(xt, Wg[g]) + Matrix::multiply(hs.back(), Ug[g]), bg[g]);
+            }
+            Matrix i = apply(pre[0], sigmoid), f = apply(pre[1], sigmoid);
+            Matrix c_hat = apply(pre[2], tanhFn), o = apply(pre[3], sigmoid);
+            Matrix c = f.hadamard(cs.back()) + i.hadamard(c_hat);
+            Matrix h = o.hadamard(apply(c, tanhFn));
+            xs.push_back(xt);
+            cs.push_back(c);
+            hs.push_back(h);
+            gate_values[0].push_back(i);
+            gate_values[1].push_back(f);
+            gate_values[2].push_back(c_hat);
+            gate_values[3].push_back(o);
+        }
+        return hs.back();
+    }
+
+    void backward(const Matrix& grad, double learning_rate) {
+        Matrix dW[4], dU[4], db[4];
+        for (int g = 0; g < 4; ++g) {
+            dW[g] = Matrix(features, hidden);
+            dU[g] = Matrix(hidden, hidden);
+            db[g] = Matrix(1, hidden);
+        }
+        Matrix dh = grad, dc(grad.rows, hidden);
+        for (int t = steps - 1; t >= 0; --t) {
+            const Matrix& i = gate_values[0][t];
+            const Matrix& f = gate_values[1][t];
+            const Matrix& c_hat = gate_values[2][t];
+            const Matrix& o = gate_values[3][t];
+            Matrix tc = apply(cs[t + 1], tanhFn);
+            dc = dc + dh.hadamard(o).hadamard(oneMinus(tc.hadamard(tc)));
+            Matrix d[4] = {
+                dc.hadamard(c_hat).hadamard(i.hadamard(oneMinus(i))),
+                dc.hadamard(cs[t]).hadamard(f.hadamard(oneMinus(f))),
+                dc.hadamard(i).hadamard(oneMinus(c_hat.hadamard(c_hat))),
+                dh.hadamard(tc).hadamard(o.hadamard(oneMinus(o))),
+            };
+            dc = dc.hadamard(f);
+            Matrix dh_prev(grad.rows, hidden);
+            for (int g = 0; g < 4; ++g) {
+                dW[g] = dW[g] + Matrix::multiply(xs[t].transpose(), d[g]);
+                dU[g] = dU[g] + Matrix::multiply(hs[t].transpose(), d[g]);
+                db[g] = db[g] + columnSums(d[g]);
+                dh_prev = dh_prev + Matrix::multiply(d[g], Ug[g].transpose());
+            }
+            dh = dh_prev;
+        }
+        for (int g = 0; g < 4; ++g) {
+            Wg[g] = Wg[g] - dW[g] * learning_rate;
+            Ug[g] = Ug[g] - dU[g] * learning_rate;
+            bg[g] = bg[g] - db[g] * learning_rate;
+        }
+    }
+};
+
+struct NaiveGRU {
+    int features, steps, hidden;
+    Matrix Wg[3], Ug[3], bg[3], cg[3];
+
+    explicit NaiveGRU(const GRU& fused, int features)
+        : features(features), steps(fused.sequenceLength()), hidden(fused.hiddenSize()) {
+        for (int g = 0; g < 3; ++g) {
+            Wg[g] = columns(fused.W, g * hidden, hidden);
+            Ug[g] = columns(fused.U, g * hidden, hidden);
+            bg[g] = columns(fused.bias, g * hidden, hidden);
+            cg[g] = columns(fused.recurrent_bias, g * hidden, hidden);
+        }
+    }
+
+    Matrix forward(const Matrix& x) {
+        Matrix h(x.rows, hidden);
+        for (int t = 0; t < steps; ++t) {
+            Matrix xt = timestep(x, t, features);
+            Matrix r = apply(addBias(Matrix::multiply(xt, Wg[0]), bg[0]) +
+                             addBias(Matrix::multiply(h, Ug[0]), cg[0]), sigmoid);
+            Matrix z = apply(addBias(Matrix::multiply(xt, Wg[1]), bg[1]) +
+                             addBias(Matrix::multiply(h, Ug[1]), cg[1]), sigmoid);
+            Matrix n = apply(addBias(Matrix::multiply(xt, Wg[2]), bg[2]) +
+                             r.hadamard(addBias(Matrix::multiply(h, Ug[2]), cg[2])), tanhFn);
+            h = oneMinus(z).hadamard(n) + z.hadamard(h);
+        }
+        return h;
+    }
+};
+
+template <typename F>
+double secondsPerCall(int calls, F f) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < calls; ++i) f();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count() / calls;
+}
+
+double maxDiff(const Matrix& a, const Matrix& b) {
+    double d = 0.0;
+    for (int i = 0; i < a.rows; ++i)
+        for (int j = 0; j < a.cols; ++j) d = std::max(d, std::abs(a.data[i][j] - b.data[i][j]));
+    return d;
+}
+
+void report(const char* name, int batch, double naive, double fused, double diff) {
+    std::cout << name << "\t" << batch / naive << "\t\t" << batch / fused << "\t\t" << naive / fused << "x\t\t"
+              << diff << std::endl;
+}
+
+} // namespace
+
+int main() {
+    const int batch = 32, steps = 20, features = 16, hidden = 64;
+    const int calls = 10;
+
+    std::cout << "=== Benchmark: LSTM/GRU fusionadas vs una multiplicación por puerta ===" << std::endl;
+    std::cout << "Lote " << batch << ", " << steps << " pasos, " << features << " entradas, " << hidden
+              << " unidades ocultas" << std::endl << std::endl;
+    std::cout << "caso\t\tingenua(sec/s)\tfusionada(sec/s)\taceleración\tdif. máx." << std::endl;
+
+    Random::seed(21);
+    Matrix x(batch, steps * features);
+    x.setRandom();
+    Matrix grad(batch, hidden);
+    grad.setRandom();
+
+    LSTM lstm(features, steps, hidden);
+    NaiveLSTM naive_lstm(lstm, features);
+    Matrix y_fused, y_naive;
+    double naive = secondsPerCall(calls, [&]() { y_naive = naive_lstm.forward(x); });
+    double fused = secondsPerCall(calls, [&]() { y_fused = lstm.forward(x); });
+    report("LSTM inferencia", batch, naive, fused, maxDiff(y_fused, y_naive));
+
+    // Training: forward plus backpropagation through time. A tiny learning
+    // rate keeps both copies' weights in step across calls.
+    naive = secondsPerCall(calls, [&]() {
+        naive_lstm.forward(x);
+        naive_lstm.backward(grad, 1e-6);
+    });
+    fused = secondsPerCall(calls, [&]() {
+        lstm.forward(x);
+        lstm.backward(grad, 1e-6);
+    });
+    report("LSTM entrenamiento", batch, naive, fused, maxDiff(lstm.forward(x), naive_lstm.forward(x)));
+
+    GRU gru(features, steps, hidden);
+    NaiveGRU naive_gru(gru, features);
+    naive = secondsPerCall(calls, [&]() { y_naive = naive_gru.forward(x); });
+    fused = secondsPerCall(calls, [&]() { y_fused = gru.forward(x); });
+    report("GRU inferencia", batch, naive, fused, maxDiff(y_fused, y_naive));
+    return 0;
+}
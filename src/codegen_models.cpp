@@ -0,0 +1,24 @@
+#include <iostream>
+#include "Codegen.h"
+#include "ModelZoo.h"
+
+// Build-time generator: trains the reference models and writes one
+// shape-specialized header per model into the given directory.
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "uso: codegen_models <directorio de salida>" << std::endl;
+        return 1;
+    }
+    std::string dir = argv[1];
+
+    Network xor_net;
+    models::buildXor(xor_net);
+    codegen::writeHeader(xor_net, "xor_net", dir + "/xor_net.h");
+
+    Network large_net;
+    models::buildLarge(large_net);
+    codegen::writeHeader(large_net, "large_net", dir + "/large_net.h");
+
+    std::cout << "Generados xor_net.h y large_net.h en " << dir << std::endl;
+    return 0;
+}
@@ -6,14 +6,25 @@
 #include <functional>
 
 class Activation : public Layer {
+public:
+    // Identifies the built-in activations so compiled plans can call an
+    // inlined kernel instead of going through std::function.
+    enum class Kind { Custom, Tanh, Sigmoid };
+
 private:
     std::function<double(double)> activation;
     std::function<double(double)> activation_prime;
+    Kind kind_;
     Matrix input;
 
 public:
-    Activation(std::function<double(double)> act, std::function<double(double)> act_prime)
-        : activation(act), activation_prime(act_prime) {}
+    Activation(std::function<double(double)> act, std::function<double(double)> act_prime,
+               Kind kind = Kind::Custom)
+        : activation(act), activation_prime(act_prime), kind_(kind) {}
+
+    Kind kind() const { return kind_; }
+    const std::function<double(double)>& function() const { return activation; }
+    const std::function<double(double)>& derivative() const { return activation_prime; }
 
     Matrix forward(const Matrix& input_mat) override {
         this->input = input_mat;
@@ -35,22 +46,27 @@ public:
         }
         return input_gradient;
     }
+    Layer* clone() const override { return new Activation(*this); }
 };
 
 class Tanh : public Activation {
 public:
     Tanh() : Activation(
         [](double x) { return std::tanh(x); },
-        [](double x) { double t = std::tanh(x); return 1 - t * t; }
+        [](double x) { double t = std::tanh(x); return 1 - t * t; },
+        Kind::Tanh
     ) {}
+    Layer* clone() const override { return new Tanh(*this); }
 };
 
 class Sigmoid : public Activation {
 public:
     Sigmoid() : Activation(
         [](double x) { return 1.0 / (1.0 + std::exp(-x)); },
-        [](double x) { double s = 1.0 / (1.0 + std::exp(-x)); return s * (1 - s); }
+        [](double x) { double s = 1.0 / (1.0 + std::exp(-x)); return s * (1 - s); },
+        Kind::Sigmoid
     ) {}
+    Layer* clone() const override { return new Sigmoid(*this); }
 };
 
 #endif // ACTIVATION_H
@@ -0,0 +1,82 @@
+#include "BlockSparseDense.h"
+#include "Dense.h"
+#include <stdexcept>
+
+BlockSparseDense::BlockSparseDense(const Dense& dense, int block_rows, int block_cols) : bias(dense.bias) {
+    if (block_rows <= 0 || block_cols <= 0) {
+        throw std::invalid_argument("BlockSparseDense: block dimensions must be positive");
+    }
+    const Matrix& W = dense.weights;
+    weights.in_size = W.rows;
+    weights.out_size = W.cols;
+    weights.block_rows = block_rows;
+    weights.block_cols = block_cols;
+
+    // Keep every tile with at least one nonzero weight
+    std::vector<std::vector<double>> tiles;
+    weights.row_start.push_back(0);
+    for (int kb = 0; kb < weights.blockRowCount(); ++kb) {
+        for (int jb = 0; jb < weights.blockColCount(); ++jb) {
+            std::vector<double> tile((size_t)block_rows * block_cols, 0.0);
+            bool nonzero = false;
+            for (int k = kb * block_rows; k < std::min(W.rows, (kb + 1) * block_rows); ++k) {
+                for (int j = jb * block_cols; j < std::min(W.cols, (jb + 1) * block_cols); ++j) {
+                    double w = W.data[k][j];
+                    tile[(size_t)(k - kb * block_rows) * block_cols + (j - jb * block_cols)] = w;
+                    nonzero = nonzero || w != 0.0;
+                }
+            }
+            if (!nonzero) continue;
+            tiles.push_back(std::move(tile));
+            weights.block_col.push_back(jb);
+        }
+        weights.row_start.push_back((int)tiles.size());
+    }
+    weights.values = Matrix((int)tiles.size(), block_rows * block_cols);
+    weights.values.data = std::move(tiles);
+}
+
+double BlockSparseDense::density() const {
+    return (double)weights.storedBlocks() / ((double)weights.blockRowCount() * weights.blockColCount());
+}
+
+Matrix BlockSparseDense::toDense() const {
+    Matrix W(weights.in_size, weights.out_size);
+    const int br = weights.block_rows, bc = weights.block_cols;
+    for (int kb = 0; kb < weights.blockRowCount(); ++kb) {
+        for (int p = weights.row_start[kb]; p < weights.row_start[kb + 1]; ++p) {
+            const int j0 = weights.block_col[p] * bc;
+            for (int k = kb * br; k < std::min(W.rows, (kb + 1) * br); ++k) {
+                for (int j = j0; j < std::min(W.cols, j0 + bc); ++j) {
+                    W.data[k][j] = weights.values.data[p][(size_t)(k - kb * br) * bc + (j - j0)];
+                }
+            }
+        }
+    }
+    return W;
+}
+
+Matrix BlockSparseDense::forward(const Matrix& input_mat) {
+    assert(input_mat.cols == weights.in_size);
+    this->input = input_mat;
+    const int n = input_mat.rows;
+    std::vector<double> x((size_t)n * weights.in_size), y((size_t)n * weights.out_size);
+    kernels::packRows(input_mat, 0, n, x.data());
+    kernels::blockSparseForward(x.data(), n, weights, bias, y.data());
+    Matrix output(n, weights.out_size);
+    kernels::unpackRows(y.data(), n, weights.out_size, output, 0);
+    return output;
+}
+
+Matrix BlockSparseDense::backward(const Matrix& output_gradient, double learning_rate) {
+    const int n = output_gradient.rows;
+    std::vector<double> x((size_t)n * weights.in_size), g((size_t)n * weights.out_size);
+    std::vector<double> dx((size_t)n * weights.in_size);
+    kernels::packRows(input, 0, n, x.data());
+    kernels::packRows(output_gradient, 0, n, g.data());
+    dw.resize((size_t)weights.storedBlocks() * weights.block_rows * weights.block_cols);
+    kernels::blockSparseBackward(x.data(), g.data(), n, weights, bias, learning_rate, dx.data(), dw.data());
+    Matrix input_gradient(n, weights.in_size);
+    kernels::unpackRows(dx.data(), n, weights.in_size, input_gradient, 0);
+    return input_gradient;
+}
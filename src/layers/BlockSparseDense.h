@@ -0,0 +1,37 @@
+#ifndef BLOCK_SPARSE_DENSE_H
+#define BLOCK_SPARSE_DENSE_H
+
+#include "Layer.h"
+#include "../Kernels.h"
+
+class Dense;
+
+// A Dense layer whose weights are stored block-sparse (see
+// kernels::BlockSparseWeights): tiles that are entirely zero, typically
+// after BlockPruner, are dropped and never visited. Predictions are
+// bit-identical to the Dense layer it was built from. Training updates the
+// stored tiles only, so pruned blocks stay pruned.
+class BlockSparseDense : public Layer {
+private:
+    Matrix input;
+    std::vector<double> dw;
+
+public:
+    kernels::BlockSparseWeights weights;
+    Matrix bias;
+
+    BlockSparseDense(const Dense& dense, int block_rows, int block_cols);
+
+    Matrix forward(const Matrix& input) override;
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+    int inputSize() const override { return weights.in_size; }
+    int outputSize(int) const override { return weights.out_size; }
+    std::vector<Matrix*> parameters() override { return {&weights.values, &bias}; }
+    Layer* clone() const override { return new BlockSparseDense(*this); }
+
+    // Fraction of tiles stored
+    double density() const;
+    Matrix toDense() const;
+};
+
+#endif // BLOCK_SPARSE_DENSE_H
@@ -0,0 +1,19 @@
+#ifndef CONV1D_H
+#define CONV1D_H
+
+#include "Conv2D.h"
+
+// 1D convolution over C x L samples: a Conv2D with height 1 and a 1 x K
+// kernel, so padding and striding only apply along the length.
+class Conv1D : public Conv2D {
+public:
+    Conv1D(int in_channels, int length, int out_channels, int kernel_size,
+           int stride = 1, int padding = 0, Layout layout = Layout::NCHW)
+        : Conv2D(Shape3{in_channels, 1, length}, out_channels, 1, kernel_size,
+                 1, stride, 0, padding, layout) {}
+    Layer* clone() const override { return new Conv1D(*this); }
+
+    int outputLength() const { return out_shape.width; }
+};
+
+#endif // CONV1D_H
@@ -0,0 +1,135 @@
+#include "Conv2D.h"
+#include <stdexcept>
+
+Conv2D::Conv2D(int in_channels, int in_height, int in_width, int out_channels,
+               int kernel_h, int kernel_w, int stride, int padding, Layout layout)
+    : Conv2D(Shape3{in_channels, in_height, in_width}, out_channels, kernel_h, kernel_w,
+             stride, stride, padding, padding, layout) {}
+
+Conv2D::Conv2D(Shape3 in_shape, int out_channels, int kernel_h, int kernel_w,
+               int stride_h, int stride_w, int pad_h, int pad_w, Layout layout)
+    : in_shape(in_shape), kernel_h(kernel_h), kernel_w(kernel_w),
+      stride_h(stride_h), stride_w(stride_w), pad_h(pad_h), pad_w(pad_w),
+      layout(layout), batch(0),
+      weights(in_shape.channels * kernel_h * kernel_w, out_channels),
+      bias(1, out_channels) {
+    int out_h = (in_shape.height + 2 * pad_h - kernel_h) / stride_h + 1;
+    int out_w = (in_shape.width + 2 * pad_w - kernel_w) / stride_w + 1;
+    if (out_h <= 0 || out_w <= 0) {
+        throw std::invalid_argument("Conv2D: kernel larger than padded input");
+    }
+    out_shape = Shape3{out_channels, out_h, out_w};
+    weights.setRandom();
+}
+
+int Conv2D::patchIndex(int c, int kh, int kw) const {
+    if (layout == Layout::NCHW) return (c * kernel_h + kh) * kernel_w + kw;
+    return (kh * kernel_w + kw) * in_shape.channels + c;
+}
+
+// One row per (sample, output position); padding positions stay zero.
+Matrix Conv2D::im2col(const Matrix& input) const {
+    const int positions = out_shape.height * out_shape.width;
+    Matrix cols(input.rows * positions, weights.rows);
+    for (int b = 0; b < input.rows; ++b) {
+        const std::vector<double>& x = input.data[b];
+        for (int oh = 0; oh < out_shape.height; ++oh) {
+            for (int ow = 0; ow < out_shape.width; ++ow) {
+                std::vector<double>& row = cols.data[b * positions + oh * out_shape.width + ow];
+                for (int kh = 0; kh < kernel_h; ++kh) {
+                    int ih = oh * stride_h - pad_h + kh;
+                    if (ih < 0 || ih >= in_shape.height) continue;
+                    for (int kw = 0; kw < kernel_w; ++kw) {
+                        int iw = ow * stride_w - pad_w + kw;
+                        if (iw < 0 || iw >= in_shape.width) continue;
+                        for (int c = 0; c < in_shape.channels; ++c) {
+                            row[patchIndex(c, kh, kw)] = x[in_shape.index(layout, c, ih, iw)];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return cols;
+}
+
+// Adjoint of im2col: scatters patch gradients back onto the input positions.
+Matrix Conv2D::col2im(const Matrix& cols) const {
+    const int positions = out_shape.height * out_shape.width;
+    Matrix grad(batch, in_shape.size());
+    for (int b = 0; b < batch; ++b) {
+        std::vector<double>& dx = grad.data[b];
+        for (int oh = 0; oh < out_shape.height; ++oh) {
+            for (int ow = 0; ow < out_shape.width; ++ow) {
+                const std::vector<double>& row = cols.data[b * positions + oh * out_shape.width + ow];
+                for (int kh = 0; kh < kernel_h; ++kh) {
+                    int ih = oh * stride_h - pad_h + kh;
+                    if (ih < 0 || ih >= in_shape.height) continue;
+                    for (int kw = 0; kw < kernel_w; ++kw) {
+                        int iw = ow * stride_w - pad_w + kw;
+                        if (iw < 0 || iw >= in_shape.width) continue;
+                        for (int c = 0; c < in_shape.channels; ++c) {
+                            dx[in_shape.index(layout, c, ih, iw)] += row[patchIndex(c, kh, kw)];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return grad;
+}
+
+Matrix Conv2D::forward(const Matrix& input) {
+    assert(input.cols == in_shape.size());
+    batch = input.rows;
+    columns = im2col(input);
+
+    // (B * OH * OW) x OC
+    Matrix result = Matrix::multiply(columns, weights);
+
+    const int positions = out_shape.height * out_shape.width;
+    Matrix output(batch, out_shape.size());
+    for (int b = 0; b < batch; ++b) {
+        for (int p = 0; p < positions; ++p) {
+            const std::vector<double>& r = result.data[b * positions + p];
+            for (int oc = 0; oc < out_shape.channels; ++oc) {
+                int idx = (layout == Layout::NCHW) ? oc * positions + p : p * out_shape.channels + oc;
+                output.data[b][idx] = r[oc] + bias.data[0][oc];
+            }
+        }
+    }
+    return output;
+}
+
+Matrix Conv2D::backward(const Matrix& output_gradient, double learning_rate) {
+    // Gather dE/dY into the same (B * OH * OW) x OC shape as the GEMM result
+    const int positions = out_shape.height * out_shape.width;
+    Matrix grad(batch * positions, out_shape.channels);
+    for (int b = 0; b < batch; ++b) {
+        for (int p = 0; p < positions; ++p) {
+            for (int oc = 0; oc < out_shape.channels; ++oc) {
+                int idx = (layout == Layout::NCHW) ? oc * positions + p : p * out_shape.channels + oc;
+                grad.data[b * positions + p][oc] = output_gradient.data[b][idx];
+            }
+        }
+    }
+
+    // dE/dW = cols^T * G, dE/db = column sums of G
+    Matrix weights_gradient = Matrix::multiply(columns.transpose(), grad);
+    Matrix bias_gradient(1, bias.cols);
+    for (int oc = 0; oc < grad.cols; ++oc) {
+        double sum = 0;
+        for (int r = 0; r < grad.rows; ++r) {
+            sum += grad.data[r][oc];
+        }
+        bias_gradient.data[0][oc] = sum;
+    }
+
+    // dE/dX = col2im(G * W^T)
+    Matrix input_gradient = col2im(Matrix::multiply(grad, weights.transpose()));
+
+    weights = weights - (weights_gradient * learning_rate);
+    bias = bias - (bias_gradient * learning_rate);
+
+    return input_gradient;
+}
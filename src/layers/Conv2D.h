@@ -0,0 +1,53 @@
+#ifndef CONV2D_H
+#define CONV2D_H
+
+#include "Layer.h"
+#include "Layout.h"
+
+// 2D convolution over samples stored one per Matrix row (C x H x W values in
+// the chosen layout). The forward pass lowers every receptive field of the
+// batch into one row of an im2col matrix and does a single Matrix::multiply
+// against the filter bank.
+//
+// Rows of `weights` are patch positions. Their order follows the layout so
+// that im2col copies contiguous runs: (c, kh, kw) for NCHW and (kh, kw, c)
+// for NHWC. Columns are output channels.
+class Conv2D : public Layer {
+protected:
+    Shape3 in_shape;
+    Shape3 out_shape;
+    int kernel_h, kernel_w;
+    int stride_h, stride_w;
+    int pad_h, pad_w;
+    Layout layout;
+    Matrix columns; // im2col of the last forward input
+    int batch;
+
+    Conv2D(Shape3 in_shape, int out_channels, int kernel_h, int kernel_w,
+           int stride_h, int stride_w, int pad_h, int pad_w, Layout layout);
+
+    int patchIndex(int c, int kh, int kw) const;
+    Matrix im2col(const Matrix& input) const;
+    Matrix col2im(const Matrix& cols) const;
+
+public:
+    Matrix weights; // (C * KH * KW) x out_channels
+    Matrix bias;    // 1 x out_channels
+
+    Conv2D(int in_channels, int in_height, int in_width, int out_channels,
+           int kernel_h, int kernel_w, int stride = 1, int padding = 0,
+           Layout layout = Layout::NCHW);
+
+    Matrix forward(const Matrix& input) override;
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+    int inputSize() const override { return in_shape.size(); }
+    int outputSize(int) const override { return out_shape.size(); }
+    std::vector<Matrix*> parameters() override { return {&weights, &bias}; }
+    Layer* clone() const override { return new Conv2D(*this); }
+
+    const Shape3& inputShape() const { return in_shape; }
+    const Shape3& outputShape() const { return out_shape; }
+    Layout getLayout() const { return layout; }
+};
+
+#endif // CONV2D_H
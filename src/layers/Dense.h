@@ -14,6 +14,10 @@ public:
     Dense(int input_size, int output_size);
     Matrix forward(const Matrix& input) override;
     Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+    int inputSize() const override { return weights.rows; }
+    int outputSize(int) const override { return weights.cols; }
+    std::vector<Matrix*> parameters() override { return {&weights, &bias}; }
+    Layer* clone() const override { return new Dense(*this); }
 };
 
 #endif // DENSE_H
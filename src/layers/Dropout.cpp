@@ -0,0 +1,53 @@
+#include "Dropout.h"
+
+Dropout::Dropout(double rate)
+    : rate(rate), training(false), seed(Random::getSeed()), stream(Random::nextStream()),
+      calls(0), rows(0), cols(0) {
+    assert(rate >= 0.0 && rate < 1.0);
+}
+
+Matrix Dropout::forward(const Matrix& input) {
+    rows = input.rows;
+    cols = input.cols;
+    if (!training || rate == 0.0) {
+        mask.clear();
+        return input;
+    }
+
+    // One 32-bit draw per element, four per Philox block; the block index
+    // combines the call number and the element so masks never repeat.
+    const size_t count = (size_t)rows * cols;
+    const uint32_t threshold = (uint32_t)(rate * 4294967296.0);
+    const uint64_t base = calls++ << 40;
+    mask.assign((count + 63) / 64, 0);
+    for (size_t b = 0; b * 4 < count; ++b) {
+        rng::Block r = rng::block(seed, stream, base + b);
+        for (int l = 0; l < 4 && b * 4 + l < count; ++l) {
+            size_t e = b * 4 + l;
+            if (r.v[l] >= threshold) mask[e >> 6] |= (uint64_t)1 << (e & 63);
+        }
+    }
+
+    const double scale = 1.0 / (1.0 - rate);
+    Matrix output(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            size_t e = (size_t)i * cols + j;
+            output.data[i][j] = kept(e) ? input.data[i][j] * scale : 0.0;
+        }
+    }
+    return output;
+}
+
+Matrix Dropout::backward(const Matrix& output_gradient, double learning_rate) {
+    if (mask.empty()) return output_gradient;
+    const double scale = 1.0 / (1.0 - rate);
+    Matrix input_gradient(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            size_t e = (size_t)i * cols + j;
+            input_gradient.data[i][j] = kept(e) ? output_gradient.data[i][j] * scale : 0.0;
+        }
+    }
+    return input_gradient;
+}
@@ -0,0 +1,33 @@
+#ifndef DROPOUT_H
+#define DROPOUT_H
+
+#include "Layer.h"
+
+// Inverted dropout: while training, each element is kept with probability
+// 1 - rate and scaled by 1 / (1 - rate); outside training it is the identity.
+// The keep mask is packed 64 elements per word and drawn from the layer's own
+// counter-based stream, so a seeded run drops the same units every time.
+class Dropout : public Layer {
+private:
+    double rate;
+    bool training;
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t calls;              // forward passes so far, part of the counter
+    std::vector<uint64_t> mask;  // bit e set = element e kept
+    int rows, cols;
+
+    bool kept(size_t e) const { return (mask[e >> 6] >> (e & 63)) & 1; }
+
+public:
+    explicit Dropout(double rate);
+
+    Matrix forward(const Matrix& input) override;
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+    void setTraining(bool training) override { this->training = training; }
+    Layer* clone() const override { return new Dropout(*this); }
+
+    const std::vector<uint64_t>& getMask() const { return mask; }
+};
+
+#endif // DROPOUT_H
@@ -8,6 +8,24 @@ public:
     virtual ~Layer() = default;
     virtual Matrix forward(const Matrix& input) = 0;
     virtual Matrix backward(const Matrix& output_gradient, double learning_rate) = 0;
+
+    // Shape contract used by Network::compile. inputSize() is the number of
+    // features the layer requires (-1 if it accepts any width) and
+    // outputSize() the number it produces for a given input width.
+    virtual int inputSize() const { return -1; }
+    virtual int outputSize(int input_size) const { return input_size; }
+
+    // Network::train switches layers into training mode for its duration.
+    // Only layers that behave differently (e.g. BatchNorm) need to care.
+    virtual void setTraining(bool training) {}
+
+    // Trainable parameters and persistent state, used to snapshot and
+    // restore weights (e.g. the best epoch during early stopping).
+    virtual std::vector<Matrix*> parameters() { return {}; }
+
+    // A deep copy of the layer, weights and state included, or nullptr if
+    // the layer does not support copying. Used by Network::clone.
+    virtual Layer* clone() const { return nullptr; }
 };
 
 #endif // LAYER_H
@@ -0,0 +1,21 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+// Memory order of one flattened sample in a Matrix row for spatial layers.
+// 1D layers use H = 1, so NCHW reads as NCW and NHWC as NWC.
+enum class Layout { NCHW, NHWC };
+
+struct Shape3 {
+    int channels;
+    int height;
+    int width;
+
+    int size() const { return channels * height * width; }
+
+    int index(Layout layout, int c, int h, int w) const {
+        if (layout == Layout::NCHW) return (c * height + h) * width + w;
+        return (h * width + w) * channels + c;
+    }
+};
+
+#endif // LAYOUT_H
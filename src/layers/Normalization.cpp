@@ -0,0 +1,151 @@
+#include "Normalization.h"
+
+BatchNorm::BatchNorm(int features, double momentum, double epsilon)
+    : features(features), momentum(momentum), epsilon(epsilon), training(false), batch_stats(false),
+      inv_std(1, features), gamma(1, features), beta(1, features),
+      running_mean(1, features), running_var(1, features) {
+    for (int j = 0; j < features; ++j) {
+        gamma.data[0][j] = 1.0;
+        running_var.data[0][j] = 1.0;
+    }
+}
+
+Matrix BatchNorm::forward(const Matrix& input) {
+    assert(input.cols == features);
+    const int n = input.rows;
+    batch_stats = training && n > 1;
+
+    std::vector<double> mean(features, 0.0);
+    std::vector<double> var(features, 0.0);
+    if (batch_stats) {
+        // Welford: one pass over the batch, row-major, all features at once
+        std::vector<double> m2(features, 0.0);
+        for (int i = 0; i < n; ++i) {
+            const std::vector<double>& x = input.data[i];
+            for (int j = 0; j < features; ++j) {
+                double delta = x[j] - mean[j];
+                mean[j] += delta / (i + 1);
+                m2[j] += delta * (x[j] - mean[j]);
+            }
+        }
+        for (int j = 0; j < features; ++j) {
+            var[j] = m2[j] / n;
+            running_mean.data[0][j] = momentum * running_mean.data[0][j] + (1 - momentum) * mean[j];
+            running_var.data[0][j] = momentum * running_var.data[0][j] + (1 - momentum) * var[j];
+        }
+    } else {
+        mean = running_mean.data[0];
+        var = running_var.data[0];
+    }
+
+    for (int j = 0; j < features; ++j) {
+        inv_std.data[0][j] = 1.0 / std::sqrt(var[j] + epsilon);
+    }
+
+    normalized = Matrix(n, features);
+    Matrix output(n, features);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < features; ++j) {
+            double x_hat = (input.data[i][j] - mean[j]) * inv_std.data[0][j];
+            normalized.data[i][j] = x_hat;
+            output.data[i][j] = gamma.data[0][j] * x_hat + beta.data[0][j];
+        }
+    }
+    return output;
+}
+
+Matrix BatchNorm::backward(const Matrix& output_gradient, double learning_rate) {
+    const int n = output_gradient.rows;
+
+    // dE/dgamma = sum(g * x_hat), dE/dbeta = sum(g)
+    std::vector<double> sum_g(features, 0.0);
+    std::vector<double> sum_g_xhat(features, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < features; ++j) {
+            double g = output_gradient.data[i][j];
+            sum_g[j] += g;
+            sum_g_xhat[j] += g * normalized.data[i][j];
+        }
+    }
+
+    Matrix input_gradient(n, features);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < features; ++j) {
+            double scale = gamma.data[0][j] * inv_std.data[0][j];
+            double g = output_gradient.data[i][j];
+            if (batch_stats) {
+                // The batch mean and variance depend on every row
+                input_gradient.data[i][j] = scale / n *
+                    (n * g - sum_g[j] - normalized.data[i][j] * sum_g_xhat[j]);
+            } else {
+                input_gradient.data[i][j] = scale * g;
+            }
+        }
+    }
+
+    for (int j = 0; j < features; ++j) {
+        gamma.data[0][j] -= learning_rate * sum_g_xhat[j];
+        beta.data[0][j] -= learning_rate * sum_g[j];
+    }
+    return input_gradient;
+}
+
+LayerNorm::LayerNorm(int features, double epsilon)
+    : features(features), epsilon(epsilon), gamma(1, features), beta(1, features) {
+    for (int j = 0; j < features; ++j) {
+        gamma.data[0][j] = 1.0;
+    }
+}
+
+Matrix LayerNorm::forward(const Matrix& input) {
+    assert(input.cols == features);
+    const int n = input.rows;
+    normalized = Matrix(n, features);
+    inv_std.assign(n, 0.0);
+    Matrix output(n, features);
+    for (int i = 0; i < n; ++i) {
+        const std::vector<double>& x = input.data[i];
+        double mean = 0, m2 = 0;
+        for (int j = 0; j < features; ++j) {
+            double delta = x[j] - mean;
+            mean += delta / (j + 1);
+            m2 += delta * (x[j] - mean);
+        }
+        inv_std[i] = 1.0 / std::sqrt(m2 / features + epsilon);
+        for (int j = 0; j < features; ++j) {
+            double x_hat = (x[j] - mean) * inv_std[i];
+            normalized.data[i][j] = x_hat;
+            output.data[i][j] = gamma.data[0][j] * x_hat + beta.data[0][j];
+        }
+    }
+    return output;
+}
+
+Matrix LayerNorm::backward(const Matrix& output_gradient, double learning_rate) {
+    const int n = output_gradient.rows;
+    Matrix input_gradient(n, features);
+    std::vector<double> sum_g(features, 0.0);
+    std::vector<double> sum_g_xhat(features, 0.0);
+    for (int i = 0; i < n; ++i) {
+        // Same formula as BatchNorm, reduced across the row instead of the column
+        double row_sum = 0, row_dot = 0;
+        for (int j = 0; j < features; ++j) {
+            double dx_hat = output_gradient.data[i][j] * gamma.data[0][j];
+            row_sum += dx_hat;
+            row_dot += dx_hat * normalized.data[i][j];
+            sum_g[j] += output_gradient.data[i][j];
+            sum_g_xhat[j] += output_gradient.data[i][j] * normalized.data[i][j];
+        }
+        for (int j = 0; j < features; ++j) {
+            double dx_hat = output_gradient.data[i][j] * gamma.data[0][j];
+            input_gradient.data[i][j] = inv_std[i] / features *
+                (features * dx_hat - row_sum - normalized.data[i][j] * row_dot);
+        }
+    }
+
+    for (int j = 0; j < features; ++j) {
+        gamma.data[0][j] -= learning_rate * sum_g_xhat[j];
+        beta.data[0][j] -= learning_rate * sum_g[j];
+    }
+    return input_gradient;
+}
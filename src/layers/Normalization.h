@@ -0,0 +1,61 @@
+#ifndef NORMALIZATION_H
+#define NORMALIZATION_H
+
+#include "Layer.h"
+
+// Batch normalization over the rows of a batch, one statistic per feature.
+// While training it normalizes with the batch mean/variance (computed in a
+// single Welford pass) and tracks running averages; otherwise it uses the
+// running averages, which is what Network::foldBatchNorm bakes into the
+// preceding Dense layer.
+class BatchNorm : public Layer {
+private:
+    int features;
+    double momentum;
+    double epsilon;
+    bool training;
+    bool batch_stats;      // whether the last forward used batch statistics
+    Matrix normalized;     // x_hat of the last forward
+    Matrix inv_std;        // 1 x features, of the last forward
+
+public:
+    Matrix gamma;          // 1 x features, scale
+    Matrix beta;           // 1 x features, shift
+    Matrix running_mean;   // 1 x features
+    Matrix running_var;    // 1 x features
+
+    BatchNorm(int features, double momentum = 0.9, double epsilon = 1e-5);
+
+    Matrix forward(const Matrix& input) override;
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+    int inputSize() const override { return features; }
+    void setTraining(bool training) override { this->training = training; }
+    std::vector<Matrix*> parameters() override { return {&gamma, &beta, &running_mean, &running_var}; }
+    Layer* clone() const override { return new BatchNorm(*this); }
+    double getEpsilon() const { return epsilon; }
+};
+
+// Layer normalization: every row is normalized across its own features, so
+// it behaves the same in training and inference and does not depend on the
+// batch size.
+class LayerNorm : public Layer {
+private:
+    int features;
+    double epsilon;
+    Matrix normalized;     // x_hat of the last forward
+    std::vector<double> inv_std; // one per row
+
+public:
+    Matrix gamma;
+    Matrix beta;
+
+    LayerNorm(int features, double epsilon = 1e-5);
+
+    Matrix forward(const Matrix& input) override;
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+    int inputSize() const override { return features; }
+    std::vector<Matrix*> parameters() override { return {&gamma, &beta}; }
+    Layer* clone() const override { return new LayerNorm(*this); }
+};
+
+#endif // NORMALIZATION_H
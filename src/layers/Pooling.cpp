@@ -0,0 +1,98 @@
+#include "Pooling.h"
+#include <stdexcept>
+
+Pool2D::Pool2D(int channels, int height, int width, int pool_h, int pool_w, int stride, Layout layout)
+    : in_shape{channels, height, width}, pool_h(pool_h), pool_w(pool_w),
+      stride_h(stride > 0 ? stride : pool_h), stride_w(stride > 0 ? stride : pool_w),
+      layout(layout), batch(0) {
+    int out_h = (height - pool_h) / stride_h + 1;
+    int out_w = (width - pool_w) / stride_w + 1;
+    if (pool_h > height || pool_w > width || out_h <= 0 || out_w <= 0) {
+        throw std::invalid_argument("Pool2D: window larger than input");
+    }
+    out_shape = Shape3{channels, out_h, out_w};
+}
+
+Matrix MaxPool::forward(const Matrix& input) {
+    assert(input.cols == in_shape.size());
+    batch = input.rows;
+    Matrix output(batch, out_shape.size());
+    argmax.assign(batch, std::vector<int>(out_shape.size(), 0));
+    for (int b = 0; b < batch; ++b) {
+        const std::vector<double>& x = input.data[b];
+        for (int c = 0; c < out_shape.channels; ++c) {
+            for (int oh = 0; oh < out_shape.height; ++oh) {
+                for (int ow = 0; ow < out_shape.width; ++ow) {
+                    int best = in_shape.index(layout, c, oh * stride_h, ow * stride_w);
+                    for (int ph = 0; ph < pool_h; ++ph) {
+                        for (int pw = 0; pw < pool_w; ++pw) {
+                            int idx = in_shape.index(layout, c, oh * stride_h + ph, ow * stride_w + pw);
+                            if (x[idx] > x[best]) best = idx;
+                        }
+                    }
+                    int out_idx = out_shape.index(layout, c, oh, ow);
+                    output.data[b][out_idx] = x[best];
+                    argmax[b][out_idx] = best;
+                }
+            }
+        }
+    }
+    return output;
+}
+
+Matrix MaxPool::backward(const Matrix& output_gradient, double learning_rate) {
+    // Gradient flows only to the element that won each window
+    Matrix input_gradient(batch, in_shape.size());
+    for (int b = 0; b < batch; ++b) {
+        for (int o = 0; o < out_shape.size(); ++o) {
+            input_gradient.data[b][argmax[b][o]] += output_gradient.data[b][o];
+        }
+    }
+    return input_gradient;
+}
+
+Matrix AvgPool::forward(const Matrix& input) {
+    assert(input.cols == in_shape.size());
+    batch = input.rows;
+    const double scale = 1.0 / (pool_h * pool_w);
+    Matrix output(batch, out_shape.size());
+    for (int b = 0; b < batch; ++b) {
+        const std::vector<double>& x = input.data[b];
+        for (int c = 0; c < out_shape.channels; ++c) {
+            for (int oh = 0; oh < out_shape.height; ++oh) {
+                for (int ow = 0; ow < out_shape.width; ++ow) {
+                    double sum = 0;
+                    for (int ph = 0; ph < pool_h; ++ph) {
+                        for (int pw = 0; pw < pool_w; ++pw) {
+                            sum += x[in_shape.index(layout, c, oh * stride_h + ph, ow * stride_w + pw)];
+                        }
+                    }
+                    output.data[b][out_shape.index(layout, c, oh, ow)] = sum * scale;
+                }
+            }
+        }
+    }
+    return output;
+}
+
+Matrix AvgPool::backward(const Matrix& output_gradient, double learning_rate) {
+    // Every element of a window receives an equal share
+    const double scale = 1.0 / (pool_h * pool_w);
+    Matrix input_gradient(batch, in_shape.size());
+    for (int b = 0; b < batch; ++b) {
+        std::vector<double>& dx = input_gradient.data[b];
+        for (int c = 0; c < out_shape.channels; ++c) {
+            for (int oh = 0; oh < out_shape.height; ++oh) {
+                for (int ow = 0; ow < out_shape.width; ++ow) {
+                    double g = output_gradient.data[b][out_shape.index(layout, c, oh, ow)] * scale;
+                    for (int ph = 0; ph < pool_h; ++ph) {
+                        for (int pw = 0; pw < pool_w; ++pw) {
+                            dx[in_shape.index(layout, c, oh * stride_h + ph, ow * stride_w + pw)] += g;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return input_gradient;
+}
@@ -0,0 +1,52 @@
+#ifndef POOLING_H
+#define POOLING_H
+
+#include "Layer.h"
+#include "Layout.h"
+
+// Common window bookkeeping for pooling layers. Windows do not pad; a stride
+// of 0 means non-overlapping windows (stride = window size). For 1D data use
+// height 1 and a 1 x K window.
+class Pool2D : public Layer {
+protected:
+    Shape3 in_shape;
+    Shape3 out_shape;
+    int pool_h, pool_w;
+    int stride_h, stride_w;
+    Layout layout;
+    int batch;
+
+    Pool2D(int channels, int height, int width, int pool_h, int pool_w, int stride, Layout layout);
+
+public:
+    int inputSize() const override { return in_shape.size(); }
+    int outputSize(int) const override { return out_shape.size(); }
+    const Shape3& outputShape() const { return out_shape; }
+};
+
+class MaxPool : public Pool2D {
+private:
+    std::vector<std::vector<int>> argmax; // input index chosen per output
+
+public:
+    MaxPool(int channels, int height, int width, int pool_h, int pool_w,
+            int stride = 0, Layout layout = Layout::NCHW)
+        : Pool2D(channels, height, width, pool_h, pool_w, stride, layout) {}
+    Layer* clone() const override { return new MaxPool(*this); }
+
+    Matrix forward(const Matrix& input) override;
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+};
+
+class AvgPool : public Pool2D {
+public:
+    AvgPool(int channels, int height, int width, int pool_h, int pool_w,
+            int stride = 0, Layout layout = Layout::NCHW)
+        : Pool2D(channels, height, width, pool_h, pool_w, stride, layout) {}
+    Layer* clone() const override { return new AvgPool(*this); }
+
+    Matrix forward(const Matrix& input) override;
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+};
+
+#endif // POOLING_H
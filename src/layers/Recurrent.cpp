@@ -0,0 +1,277 @@
+#include "Recurrent.h"
+#include "../Kernels.h"
+#include <stdexcept>
+
+namespace {
+
+inline double sigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+
+// y[0, W.cols) += x[0, W.rows) * W
+inline void addRowTimesMatrix(const double* x, const Matrix& W, double* y) {
+    for (int k = 0; k < W.rows; ++k) {
+        const double xk = x[k];
+        const double* wk = W.data[k].data();
+        for (int j = 0; j < W.cols; ++j) y[j] += xk * wk[j];
+    }
+}
+
+} // namespace
+
+Recurrent::Recurrent(int features, int steps, int hidden, int gate_count, bool return_sequences)
+    : features(features), steps(steps), hidden(hidden), gate_count(gate_count),
+      return_sequences(return_sequences),
+      W(features, gate_count * hidden), U(hidden, gate_count * hidden), bias(1, gate_count * hidden) {
+    if (features <= 0 || steps <= 0 || hidden <= 0) {
+        throw std::invalid_argument("Recurrent: features, steps and hidden must be positive");
+    }
+    W.setRandom();
+    U.setRandom();
+}
+
+void Recurrent::allocate(int n) {
+    if (n == batch) return;
+    batch = n;
+    const size_t G = gateWidth();
+    x_buf.assign((size_t)n * steps * features, 0.0);
+    gates.assign((size_t)n * steps * G, 0.0);
+    h_buf.assign((size_t)n * (steps + 1) * hidden, 0.0);
+    d_gates.assign((size_t)n * steps * G, 0.0);
+    dh.assign((size_t)n * hidden, 0.0);
+    dh_next.assign((size_t)n * hidden, 0.0);
+    dx.assign((size_t)n * steps * features, 0.0);
+    dw.assign((size_t)features * G, 0.0);
+    du.assign((size_t)hidden * G, 0.0);
+}
+
+Matrix Recurrent::forward(const Matrix& input) {
+    assert(input.cols == steps * features);
+    allocate(input.rows);
+    const int G = gateWidth();
+
+    // Input projection of every (sample, timestep) pair in one GEMM: the
+    // packed input is (batch * steps) x features in row-major order
+    kernels::packRows(input, 0, batch, x_buf.data());
+    kernels::denseForward(kernels::selectDenseKernel(features, G), x_buf.data(), batch * steps,
+                          features, G, W, bias, gates.data());
+
+    for (int t = 0; t < steps; ++t) stepForward(t);
+
+    Matrix output(batch, outputSize(inputSize()));
+    for (int b = 0; b < batch; ++b) {
+        std::vector<double>& row = output.data[b];
+        if (return_sequences) {
+            const double* h = hiddenRow(b, 1);
+            for (int j = 0; j < steps * hidden; ++j) row[j] = h[j];
+        } else {
+            const double* h = hiddenRow(b, steps);
+            for (int j = 0; j < hidden; ++j) row[j] = h[j];
+        }
+    }
+    return output;
+}
+
+void Recurrent::backpropRecurrent(const double* grad, double* dh_prev) const {
+    const int G = gateWidth();
+    for (int k = 0; k < hidden; ++k) {
+        const double* uk = U.data[k].data();
+        double sum = 0.0;
+        for (int j = 0; j < G; ++j) sum += grad[j] * uk[j];
+        dh_prev[k] += sum;
+    }
+}
+
+Matrix Recurrent::backward(const Matrix& output_gradient, double learning_rate) {
+    assert(output_gradient.rows == batch && output_gradient.cols == outputSize(inputSize()));
+    const int G = gateWidth();
+
+    std::fill(dh_next.begin(), dh_next.end(), 0.0);
+    for (int t = steps - 1; t >= 0; --t) {
+        for (int b = 0; b < batch; ++b) {
+            const std::vector<double>& g = output_gradient.data[b];
+            double* dhb = dh.data() + (size_t)b * hidden;
+            const double* carried = dh_next.data() + (size_t)b * hidden;
+            for (int j = 0; j < hidden; ++j) {
+                double from_output = 0.0;
+                if (return_sequences) from_output = g[(size_t)t * hidden + j];
+                else if (t == steps - 1) from_output = g[j];
+                dhb[j] = carried[j] + from_output;
+            }
+        }
+        stepBackward(t);
+    }
+
+    // Recurrent weights: dU = sum over (b, t) of h_{t-1}^T * grad_t. Every
+    // step has already used U, so it can be updated now.
+    const double* rgrad = recurrentGradients();
+    std::fill(du.begin(), du.end(), 0.0);
+    for (int b = 0; b < batch; ++b) {
+        for (int t = 0; t < steps; ++t) {
+            const double* h = h_buf.data() + ((size_t)b * (steps + 1) + t) * hidden;
+            const double* gr = rgrad + ((size_t)b * steps + t) * G;
+            for (int k = 0; k < hidden; ++k) {
+                const double hk = h[k];
+                double* duk = du.data() + (size_t)k * G;
+                for (int j = 0; j < G; ++j) duk[j] += hk * gr[j];
+            }
+        }
+    }
+    for (int k = 0; k < hidden; ++k) {
+        double* uk = U.data[k].data();
+        const double* duk = du.data() + (size_t)k * G;
+        for (int j = 0; j < G; ++j) uk[j] = uk[j] - duk[j] * learning_rate;
+    }
+
+    // Input projection, time-batched like the forward pass: dX = dG * W^T,
+    // W -= lr * X^T * dG and bias -= lr * sum(dG) over all (batch * steps) rows
+    kernels::denseBackward(x_buf.data(), d_gates.data(), batch * steps, features, G, W, bias,
+                           learning_rate, dx.data(), dw.data());
+
+    Matrix input_gradient(batch, steps * features);
+    kernels::unpackRows(dx.data(), batch, steps * features, input_gradient, 0);
+    return input_gradient;
+}
+
+// ---------------------------------------------------------------------------
+// LSTM
+
+LSTM::LSTM(int features, int steps, int hidden, bool return_sequences)
+    : Recurrent(features, steps, hidden, 4, return_sequences) {
+    for (int j = 0; j < hidden; ++j) bias.data[0][hidden + j] = 1.0;
+}
+
+void LSTM::allocate(int n) {
+    if (n == batch) return;
+    Recurrent::allocate(n);
+    c_buf.assign((size_t)n * (steps + 1) * hidden, 0.0);
+    tanh_c.assign((size_t)n * steps * hidden, 0.0);
+    dc_next.assign((size_t)n * hidden, 0.0);
+}
+
+void LSTM::stepForward(int t) {
+    const int H = hidden;
+    for (int b = 0; b < batch; ++b) {
+        double* g = gateRow(b, t);
+        const double* h_prev = hiddenRow(b, t);
+        double* h = hiddenRow(b, t + 1);
+        const double* c_prev = c_buf.data() + ((size_t)b * (steps + 1) + t) * H;
+        double* c = c_buf.data() + ((size_t)b * (steps + 1) + t + 1) * H;
+        double* tc = tanh_c.data() + ((size_t)b * steps + t) * H;
+
+        // All four gates in one product, then the gate math while the row is hot
+        addRowTimesMatrix(h_prev, U, g);
+        for (int j = 0; j < H; ++j) {
+            double i_gate = sigmoid(g[j]);
+            double f_gate = sigmoid(g[H + j]);
+            double candidate = std::tanh(g[2 * H + j]);
+            double o_gate = sigmoid(g[3 * H + j]);
+            c[j] = f_gate * c_prev[j] + i_gate * candidate;
+            tc[j] = std::tanh(c[j]);
+            h[j] = o_gate * tc[j];
+            g[j] = i_gate;
+            g[H + j] = f_gate;
+            g[2 * H + j] = candidate;
+            g[3 * H + j] = o_gate;
+        }
+    }
+}
+
+void LSTM::stepBackward(int t) {
+    const int H = hidden;
+    if (t == steps - 1) std::fill(dc_next.begin(), dc_next.end(), 0.0);
+    std::fill(dh_next.begin(), dh_next.end(), 0.0);
+    for (int b = 0; b < batch; ++b) {
+        const double* g = gateRow(b, t);
+        const double* c_prev = c_buf.data() + ((size_t)b * (steps + 1) + t) * H;
+        const double* tc = tanh_c.data() + ((size_t)b * steps + t) * H;
+        const double* dhb = dh.data() + (size_t)b * H;
+        double* dcb = dc_next.data() + (size_t)b * H;
+        double* dg = d_gates.data() + ((size_t)b * steps + t) * gateWidth();
+
+        for (int j = 0; j < H; ++j) {
+            double i_gate = g[j], f_gate = g[H + j], candidate = g[2 * H + j], o_gate = g[3 * H + j];
+            double dc = dcb[j] + dhb[j] * o_gate * (1 - tc[j] * tc[j]);
+            dcb[j] = dc * f_gate;
+            dg[j] = dc * candidate * i_gate * (1 - i_gate);
+            dg[H + j] = dc * c_prev[j] * f_gate * (1 - f_gate);
+            dg[2 * H + j] = dc * i_gate * (1 - candidate * candidate);
+            dg[3 * H + j] = dhb[j] * tc[j] * o_gate * (1 - o_gate);
+        }
+        backpropRecurrent(dg, dh_next.data() + (size_t)b * H);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// GRU
+
+GRU::GRU(int features, int steps, int hidden, bool return_sequences)
+    : Recurrent(features, steps, hidden, 3, return_sequences), recurrent_bias(1, 3 * hidden) {}
+
+void GRU::allocate(int n) {
+    if (n == batch) return;
+    Recurrent::allocate(n);
+    hu_buf.assign((size_t)n * steps * gateWidth(), 0.0);
+    d_hgates.assign((size_t)n * steps * gateWidth(), 0.0);
+}
+
+void GRU::stepForward(int t) {
+    const int H = hidden;
+    const int G = gateWidth();
+    const double* c = recurrent_bias.data[0].data();
+    for (int b = 0; b < batch; ++b) {
+        double* g = gateRow(b, t);
+        const double* h_prev = hiddenRow(b, t);
+        double* h = hiddenRow(b, t + 1);
+        double* hu = hu_buf.data() + ((size_t)b * steps + t) * G;
+
+        for (int j = 0; j < G; ++j) hu[j] = c[j];
+        addRowTimesMatrix(h_prev, U, hu);
+        for (int j = 0; j < H; ++j) {
+            double r = sigmoid(g[j] + hu[j]);
+            double z = sigmoid(g[H + j] + hu[H + j]);
+            double n = std::tanh(g[2 * H + j] + r * hu[2 * H + j]);
+            h[j] = (1 - z) * n + z * h_prev[j];
+            g[j] = r;
+            g[H + j] = z;
+            g[2 * H + j] = n;
+        }
+    }
+}
+
+void GRU::stepBackward(int t) {
+    const int H = hidden;
+    const int G = gateWidth();
+    for (int b = 0; b < batch; ++b) {
+        const double* g = gateRow(b, t);
+        const double* h_prev = hiddenRow(b, t);
+        const double* hu = hu_buf.data() + ((size_t)b * steps + t) * G;
+        const double* dhb = dh.data() + (size_t)b * H;
+        double* dgx = d_gates.data() + ((size_t)b * steps + t) * G;
+        double* dgh = d_hgates.data() + ((size_t)b * steps + t) * G;
+        double* dh_prev = dh_next.data() + (size_t)b * H;
+
+        for (int j = 0; j < H; ++j) {
+            double r = g[j], z = g[H + j], n = g[2 * H + j];
+            double dn = dhb[j] * (1 - z) * (1 - n * n);
+            double dz = dhb[j] * (h_prev[j] - n) * z * (1 - z);
+            double dr = dn * hu[2 * H + j] * r * (1 - r);
+            dgx[j] = dgh[j] = dr;
+            dgx[H + j] = dgh[H + j] = dz;
+            dgx[2 * H + j] = dn;
+            dgh[2 * H + j] = dn * r;
+            dh_prev[j] = dhb[j] * z;
+        }
+        backpropRecurrent(dgh, dh_prev);
+    }
+}
+
+Matrix GRU::backward(const Matrix& output_gradient, double learning_rate) {
+    Matrix input_gradient = Recurrent::backward(output_gradient, learning_rate);
+    const int G = gateWidth();
+    double* c = recurrent_bias.data[0].data();
+    for (int j = 0; j < G; ++j) {
+        double sum = 0.0;
+        for (size_t row = 0; row < (size_t)batch * steps; ++row) sum += d_hgates[row * G + j];
+        c[j] = c[j] - sum * learning_rate;
+    }
+    return input_gradient;
+}
@@ -0,0 +1,132 @@
+#ifndef RECURRENT_H
+#define RECURRENT_H
+
+#include "Layer.h"
+
+// Base of the recurrent layers. A sample is a sequence of `steps` timesteps
+// of `features` values, stored one sample per Matrix row in time-major order
+// (timestep t at columns [t * features, (t + 1) * features), as in Conv1D's
+// NWC layout). The output is the last hidden state (hidden values) or, with
+// return_sequences, every hidden state (steps * hidden values, same order).
+//
+// All gates share one weight matrix: W (features x gates * hidden) for the
+// input and U (hidden x gates * hidden) for the previous hidden state, gate
+// blocks side by side. The input projection X * W + bias does not depend on
+// the recurrence, so forward() computes it for every sample and timestep as
+// a single (batch * steps) x features GEMM up front; each step then adds
+// h_{t-1} * U and applies the gate math to the row while it is in cache.
+// backward() stores the gate gradients of every step and turns them into
+// dE/dX, dE/dW and dE/dbias with one time-batched GEMM each as well.
+//
+// Activations and gradients live in buffers sized on the first call with a
+// given batch size and reused afterwards, so training allocates nothing per
+// step.
+class Recurrent : public Layer {
+protected:
+    int features;
+    int steps;
+    int hidden;
+    int gate_count;
+    bool return_sequences;
+    int batch = 0;
+
+    // Forward state, indexed [sample][timestep][...]
+    std::vector<double> x_buf;   // batch x steps x features, the packed input
+    std::vector<double> gates;   // batch x steps x G: input projection, then the activated gates
+    std::vector<double> h_buf;   // batch x (steps + 1) x hidden; h_0 = 0 at timestep 0
+
+    // Backward scratch
+    std::vector<double> d_gates; // batch x steps x G, dE/d(pre-activation) of the input projection
+    std::vector<double> dh;      // batch x hidden, dE/dh_t
+    std::vector<double> dh_next; // batch x hidden, dE/dh_{t-1} carried to the previous step
+    std::vector<double> dx;      // batch x steps x features
+    std::vector<double> dw, du;  // weight gradients, features x G and hidden x G
+
+    Recurrent(int features, int steps, int hidden, int gate_count, bool return_sequences);
+
+    int gateWidth() const { return gate_count * hidden; }
+    double* gateRow(int b, int t) { return gates.data() + ((size_t)b * steps + t) * gateWidth(); }
+    double* hiddenRow(int b, int t) { return h_buf.data() + ((size_t)b * (steps + 1) + t) * hidden; }
+
+    // Sizes (and zeroes) every buffer for `n` samples if the batch changed.
+    virtual void allocate(int n);
+
+    // Runs timestep t for every sample: gateRow(b, t) holds the input
+    // projection on entry; hiddenRow(b, t + 1) receives h_t.
+    virtual void stepForward(int t) = 0;
+
+    // With dh = dE/dh_t, writes the gate gradients of timestep t into
+    // d_gates (and any layer-specific buffers) and dE/dh_{t-1} into dh_next.
+    virtual void stepBackward(int t) = 0;
+
+    // Gradient with respect to h_{t-1} * U (+ recurrent bias), same layout as
+    // d_gates. For the LSTM it is d_gates itself.
+    virtual const double* recurrentGradients() const { return d_gates.data(); }
+
+    // dh_next[b] += grad * U^T, for one sample's gate gradient row
+    void backpropRecurrent(const double* grad, double* dh_prev) const;
+
+public:
+    Matrix W;    // features x G
+    Matrix U;    // hidden x G
+    Matrix bias; // 1 x G
+
+    Matrix forward(const Matrix& input) override;
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+    int inputSize() const override { return steps * features; }
+    int outputSize(int) const override { return return_sequences ? steps * hidden : hidden; }
+    std::vector<Matrix*> parameters() override { return {&W, &U, &bias}; }
+
+    int sequenceLength() const { return steps; }
+    int hiddenSize() const { return hidden; }
+};
+
+// Long short-term memory. Gate blocks in W, U and bias are ordered input,
+// forget, cell candidate, output:
+//   i = sigmoid(.), f = sigmoid(.), g = tanh(.), o = sigmoid(.)
+//   c_t = f * c_{t-1} + i * g,  h_t = o * tanh(c_t)
+// The forget gate bias starts at 1 so early training keeps the cell state.
+class LSTM : public Recurrent {
+private:
+    std::vector<double> c_buf;   // batch x (steps + 1) x hidden; c_0 = 0
+    std::vector<double> tanh_c;  // batch x steps x hidden
+    std::vector<double> dc_next; // batch x hidden
+
+    void allocate(int n) override;
+    void stepForward(int t) override;
+    void stepBackward(int t) override;
+
+public:
+    LSTM(int features, int steps, int hidden, bool return_sequences = false);
+    Layer* clone() const override { return new LSTM(*this); }
+};
+
+// Gated recurrent unit with the reset gate applied after the recurrent
+// product (as in cuDNN), so h_{t-1} * U is one GEMM for all three gates.
+// Gate blocks are ordered reset, update, candidate:
+//   r = sigmoid(x W_r + b_r + h U_r + c_r)
+//   z = sigmoid(x W_z + b_z + h U_z + c_z)
+//   n = tanh(x W_n + b_n + r * (h U_n + c_n))
+//   h_t = (1 - z) * n + z * h_{t-1}
+// where c is recurrent_bias.
+class GRU : public Recurrent {
+private:
+    std::vector<double> hu_buf;    // batch x steps x G, h_{t-1} * U + recurrent_bias
+    std::vector<double> d_hgates;  // batch x steps x G, dE/d(h_{t-1} * U + recurrent_bias)
+
+    void allocate(int n) override;
+    void stepForward(int t) override;
+    void stepBackward(int t) override;
+    const double* recurrentGradients() const override { return d_hgates.data(); }
+
+public:
+    Matrix recurrent_bias; // 1 x G
+
+    GRU(int features, int steps, int hidden, bool return_sequences = false);
+
+    Matrix backward(const Matrix& output_gradient, double learning_rate) override;
+    std::vector<Matrix*> parameters() override { return {&W, &U, &bias, &recurrent_bias}; }
+    Layer* clone() const override { return new GRU(*this); }
+};
+
+#endif // RECURRENT_H
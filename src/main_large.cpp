@@ -1,9 +1,11 @@
 #include <iostream>
 #include <cmath>
 #include <chrono>
+#include <random>
 #include "Network.h"
 #include "layers/Dense.h"
 #include "layers/Activation.h"
+#include "layers/Normalization.h"
 
 int main() {
     std::cout << "=== Demo de Entrenamiento de Red Neuronal a Gran Escala ===" << std::endl;
@@ -26,9 +28,10 @@ int main() {
     Matrix X(num_samples, input_dim);
     Matrix Y(num_samples, output_dim);
 
-    // Generar datos sintéticos
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // Generar datos sintéticos (semilla fija: ejecuciones reproducibles)
+    const unsigned seed = 42;
+    Random::seed(seed);
+    std::mt19937 gen(seed);
     std::uniform_real_distribution<> dis(-3.14159, 3.14159);
 
     for (int i = 0; i < num_samples; ++i) {
@@ -58,14 +61,17 @@ int main() {
     
     // Capa 1: Entrada a primera capa oculta
     net.add(new Dense(input_dim, 50));
+    net.add(new BatchNorm(50));
     net.add(new Tanh());
     
     // Capa 2: Primera a segunda capa oculta
     net.add(new Dense(50, 30));
+    net.add(new BatchNorm(30));
     net.add(new Tanh());
     
     // Capa 3: Segunda a tercera capa oculta
     net.add(new Dense(30, 10));
+    net.add(new BatchNorm(10));
     net.add(new Tanh());
     
     // Capa 4: Tercera capa oculta a salida
@@ -73,16 +79,32 @@ int main() {
     net.add(new Sigmoid());
 
     std::cout << "¡Red construida exitosamente!" << std::endl;
-    std::cout << "Total de capas: 8 (4 Dense + 4 Activation)" << std::endl;
+    std::cout << "Total de capas: 11 (4 Dense + 3 BatchNorm + 4 Activation)" << std::endl;
     std::cout << std::endl;
 
     // Parámetros de entrenamiento
     const int epochs = 1000;
-    const double learning_rate = 0.01;
+    const double learning_rate = 0.1;
+
+    // Validación con el 20% final del dataset cada 10 épocas; la tasa se
+    // reduce a la mitad tras 5 validaciones sin mejora y el entrenamiento se
+    // detiene tras 15, restaurando los mejores pesos
+    TrainingOptions options;
+    options.epochs = epochs;
+    options.schedule = LearningRateSchedule::plateau(learning_rate, 0.5, 5);
+    options.validation_split = 0.2;
+    options.validation_every = 10;
+    options.patience = 15;
 
     std::cout << "Parámetros de entrenamiento:" << std::endl;
-    std::cout << "Épocas: " << epochs << std::endl;
-    std::cout << "Tasa de aprendizaje: " << learning_rate << std::endl;
+    std::cout << "Épocas (máximo): " << epochs << std::endl;
+    std::cout << "Tasa de aprendizaje inicial: " << learning_rate << std::endl;
+    std::cout << "Validación: " << options.validation_split * 100 << "% de las muestras" << std::endl;
+    std::cout << std::endl;
+
+    // Congelar la red en un plan de ejecución para lotes de todo el dataset
+    net.compile(num_samples);
+    net.getPlan()->print(std::cout);
     std::cout << std::endl;
 
     std::cout << "Iniciando entrenamiento..." << std::endl;
@@ -93,7 +115,7 @@ int main() {
     auto start_time = std::chrono::high_resolution_clock::now();
 
     // Entrenar
-    net.train(X, Y, epochs, learning_rate);
+    TrainingHistory history = net.fit(X, Y, options);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::seconds>(end_time - start_time);
@@ -102,6 +124,17 @@ int main() {
     std::cout << "¡Entrenamiento completado!" << std::endl;
     std::cout << "Tiempo total de entrenamiento: " << duration.count() << " segundos";
     std::cout << " (" << duration.count() / 60 << "m " << duration.count() % 60 << "s)" << std::endl;
+    std::cout << "Épocas ejecutadas: " << history.epochs_run << "/" << epochs
+              << (history.stopped_early ? " (parada temprana)" : "") << std::endl;
+    std::cout << "Mejor error de validación: " << history.best_validation_loss
+              << " (época " << history.best_epoch << ")" << std::endl;
+    std::cout << std::endl;
+
+    // Plegar las BatchNorm en las capas Dense previas: la normalización no
+    // cuesta nada en inferencia
+    int folded = net.foldBatchNorm();
+    net.compile(num_samples);
+    std::cout << "Capas BatchNorm plegadas en Dense: " << folded << std::endl;
     std::cout << std::endl;
 
     // Probar con un subconjunto de los datos
@@ -164,36 +197,18 @@ int main() {
 
     // Evaluación en dataset completo
     std::cout << "Evaluando en dataset completo (" << num_samples << " muestras)..." << std::endl;
-    Matrix full_predictions = net.predict(X);
-    
-    int full_correct = 0;
-    double full_total_error = 0.0;
-    
-    for (int i = 0; i < num_samples; ++i) {
-        double expected = Y.data[i][0];
-        double predicted = full_predictions.data[i][0];
-        double error = std::abs(expected - predicted);
-        
-        int predicted_class = (predicted >= 0.5) ? 1 : 0;
-        int expected_class = (expected >= 0.5) ? 1 : 0;
-        
-        if (predicted_class == expected_class) {
-            full_correct++;
-        }
-        
-        full_total_error += error;
-    }
-    
-    double full_binary_precision = (double)full_correct / num_samples * 100.0;
-    double full_mae = full_total_error / num_samples;
-    double full_numerical_precision = (1.0 - full_mae) * 100.0;
-    
+    Metrics full = net.evaluate(X, Y);
+    double full_numerical_precision = (1.0 - full.mae()) * 100.0;
+    uint64_t full_correct = full.confusion(0, 0) + full.confusion(1, 1);
+
     std::cout << std::endl;
     std::cout << "=== PRECISIÓN FINAL (Dataset Completo) ===" << std::endl;
-    std::cout << "Precisión de Clasificación Binaria: " << full_binary_precision << "% ("
+    std::cout << "Precisión de Clasificación Binaria: " << full.accuracy() * 100.0 << "% ("
               << full_correct << "/" << num_samples << " correctas)" << std::endl;
-    std::cout << "Error Absoluto Medio (MAE): " << full_mae << std::endl;
+    std::cout << "Error Absoluto Medio (MAE): " << full.mae() << std::endl;
     std::cout << "Precisión Numérica: " << full_numerical_precision << "%" << std::endl;
+    std::cout << "ROC-AUC: " << full.rocAuc() << std::endl;
+    std::cout << "Clase 1: precisión " << full.precision(1) << ", exhaustividad " << full.recall(1) << std::endl;
     std::cout << "===========================================" << std::endl;
 
     return 0;
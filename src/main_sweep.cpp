@@ -0,0 +1,49 @@
+#include <iostream>
+#include "Sweep.h"
+#include "ModelZoo.h"
+
+// Hyperparameter sweep over the main_large.cpp task: every configuration of
+// the grid is trained concurrently, and after each rung of 50 epochs only
+// the better half goes on.
+int main() {
+    std::cout << "=== Búsqueda de hiperparámetros (tarea de main_large) ===" << std::endl;
+
+    Matrix X, Y;
+    models::makeLargeDataset(1000, X, Y);
+    Matrix X_train(800, X.cols), Y_train(800, 1), X_val(200, X.cols), Y_val(200, 1);
+    for (int i = 0; i < 1000; ++i) {
+        if (i < 800) {
+            X_train.data[i] = X.data[i];
+            Y_train.data[i] = Y.data[i];
+        } else {
+            X_val.data[i - 800] = X.data[i];
+            Y_val.data[i - 800] = Y.data[i];
+        }
+    }
+
+    SearchSpace space;
+    space.hidden = {{16}, {50}, {32, 16}, {50, 30, 10}};
+    space.activations = {Activation::Kind::Tanh, Activation::Kind::Sigmoid};
+    space.learning_rates = {0.03, 0.1, 0.3};
+    space.epochs = {400};
+    std::vector<SweepConfig> configs = space.grid();
+
+    SweepOptions options;
+    options.rung_epochs = 50;
+    options.eta = 2;
+    HyperparameterSweep sweep(X_train, Y_train, X_val, Y_val, options);
+
+    std::cout << configs.size() << " configuraciones, " << parallel::defaultThreads() << " hilos, rungs de "
+              << options.rung_epochs << " épocas (eta = " << options.eta << ")" << std::endl << std::endl;
+
+    SweepReport report = sweep.run(configs);
+    report.print(std::cout, 12);
+
+    std::cout << std::endl
+              << "Tiempo total: " << report.wall_seconds << " s" << std::endl
+              << "Suma de tiempos de los ensayos: " << report.trial_seconds << " s ("
+              << report.trial_seconds / report.wall_seconds << "x en paralelo)" << std::endl
+              << "Robos de tareas: " << report.steals << std::endl
+              << "Mejor configuración: " << report.results[0].config.describe() << std::endl;
+    return 0;
+}
@@ -0,0 +1,29 @@
+#ifndef TEST_DATA_H
+#define TEST_DATA_H
+
+#include "../src/Matrix.h"
+#include <cmath>
+#include <cstdint>
+
+// Two inputs on a sin/cos curve and an XOR-style label (1 when they have
+// the same sign), shared by the tests that train a small classifier.
+
+// Writes rows [row0, row0 + n) of the sequence into the first n rows of X
+// (n x 2) and Y (n x 1).
+static inline void makeRows(uint64_t row0, int n, Matrix& X, Matrix& Y) {
+    for (int i = 0; i < n; ++i) {
+        double k = (double)(row0 + i);
+        X.data[i][0] = std::sin(0.7 * k);
+        X.data[i][1] = std::cos(1.3 * k);
+        Y.data[i][0] = (X.data[i][0] * X.data[i][1] > 0) ? 1.0 : 0.0;
+    }
+}
+
+// The first n rows
+static inline void makeData(int n, Matrix& X, Matrix& Y) {
+    X = Matrix(n, 2);
+    Y = Matrix(n, 1);
+    makeRows(0, n, X, Y);
+}
+
+#endif // TEST_DATA_H
@@ -0,0 +1,116 @@
+#include "../src/Codegen.h"
+#include "../src/ModelZoo.h"
+#include "../src/layers/Conv2D.h"
+#include "xor_net.h"
+#include "large_net.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+// xor_net.h and large_net.h are generated at build time by codegen_models
+// from the same seeded models rebuilt here.
+
+void test_generated_xor_matches() {
+    Network net;
+    models::buildXor(net);
+    static_assert(xor_net::INPUT_SIZE == 2 && xor_net::OUTPUT_SIZE == 1, "shape constants");
+
+    Matrix X(4, 2);
+    X.data = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    Matrix expected = net.predict(X);
+    double out[4];
+    xor_net::predict(&X.data[0][0], out, 1);
+    for (int i = 0; i < 4; ++i) {
+        xor_net::predict(X.data[i].data(), &out[i]);
+        assert(std::abs(out[i] - expected.data[i][0]) < 1e-12);
+    }
+
+    std::cout << "[PASS] Generated XOR network test" << std::endl;
+}
+
+void test_generated_large_matches() {
+    Network net;
+    models::buildLarge(net);
+    static_assert(large_net::INPUT_SIZE == 10 && large_net::OUTPUT_SIZE == 1, "shape constants");
+
+    Matrix X, Y;
+    models::makeLargeDataset(64, X, Y);
+    Matrix expected = net.predict(X);
+
+    std::vector<double> flat;
+    for (const std::vector<double>& row : X.data) flat.insert(flat.end(), row.begin(), row.end());
+    std::vector<double> out(64);
+    large_net::predict(flat.data(), out.data(), 64);
+    for (int i = 0; i < 64; ++i) {
+        assert(std::abs(out[i] - expected.data[i][0]) < 1e-12);
+    }
+
+    std::cout << "[PASS] Generated 10-50-30-10-1 network test" << std::endl;
+}
+
+void test_generated_source() {
+    Network net;
+    net.add(new Dense(3, 4));
+    net.add(new Sigmoid());
+    std::string code = codegen::generateHeader(net, "tiny");
+
+    assert(code.find("namespace tiny {") != std::string::npos);
+    assert(code.find("constexpr int INPUT_SIZE = 3;") != std::string::npos);
+    assert(code.find("constexpr int OUTPUT_SIZE = 4;") != std::string::npos);
+    assert(code.find("alignas(64) constexpr double L0_W[L0_IN][L0_OUT]") != std::string::npos);
+    assert(code.find("Matrix") == std::string::npos);
+    assert(code.find("virtual") == std::string::npos);
+    assert(code.find("new ") == std::string::npos);
+
+    // Unrolled: one statement per output, bias added after the sum
+    assert(code.find("y[3] = x[0] * L0_W[0][3] + x[1] * L0_W[1][3] + x[2] * L0_W[2][3] + L0_B[3];") !=
+           std::string::npos);
+
+    std::cout << "[PASS] Generated source test" << std::endl;
+}
+
+void test_unsupported_layers() {
+    bool threw = false;
+    Network conv;
+    conv.add(new Conv2D(1, 4, 4, 2, 3, 3));
+    try {
+        codegen::generateHeader(conv, "conv");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    Network custom;
+    custom.add(new Dense(2, 2));
+    custom.add(new Activation([](double x) { return x; }, [](double) { return 1.0; }));
+    try {
+        codegen::generateHeader(custom, "custom");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        codegen::generateHeader(custom, "2bad-name");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "[PASS] Unsupported layers test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Codegen tests..." << std::endl;
+
+    test_generated_xor_matches();
+    test_generated_large_matches();
+    test_generated_source();
+    test_unsupported_layers();
+
+    std::cout << "\nAll Codegen tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include "../src/layers/Conv2D.h"
+#include "../src/layers/Conv1D.h"
+#include "../src/layers/Pooling.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+void test_conv2d_forward() {
+    // 1 channel 3x3 input, one 2x2 filter
+    Conv2D conv(1, 3, 3, 1, 2, 2);
+    conv.weights.data = {{1}, {0}, {0}, {-1}};
+    conv.bias.data = {{0.5}};
+
+    Matrix input(1, 9);
+    input.data = {{1, 2, 3, 4, 5, 6, 7, 8, 9}};
+
+    Matrix output = conv.forward(input);
+
+    // Each output is x[h][w] - x[h+1][w+1] + 0.5 = -4 + 0.5
+    assert(output.rows == 1);
+    assert(output.cols == 4);
+    for (int j = 0; j < 4; ++j) {
+        assert(std::abs(output.data[0][j] - (-3.5)) < 1e-9);
+    }
+
+    std::cout << "[PASS] Conv2D forward pass test" << std::endl;
+}
+
+void test_conv2d_layouts_agree() {
+    const int C = 2, H = 4, W = 5, OC = 3;
+    Conv2D nchw(C, H, W, OC, 3, 3, 1, 1, Layout::NCHW);
+    Conv2D nhwc(C, H, W, OC, 3, 3, 1, 1, Layout::NHWC);
+
+    // Same filters, reordered to each layout's patch order
+    for (int c = 0; c < C; ++c) {
+        for (int kh = 0; kh < 3; ++kh) {
+            for (int kw = 0; kw < 3; ++kw) {
+                nhwc.weights.data[(kh * 3 + kw) * C + c] = nchw.weights.data[(c * 3 + kh) * 3 + kw];
+            }
+        }
+    }
+
+    Shape3 in{C, H, W};
+    Matrix x_nchw(2, in.size());
+    x_nchw.setRandom();
+    Matrix x_nhwc(2, in.size());
+    for (int b = 0; b < 2; ++b) {
+        for (int c = 0; c < C; ++c) {
+            for (int h = 0; h < H; ++h) {
+                for (int w = 0; w < W; ++w) {
+                    x_nhwc.data[b][in.index(Layout::NHWC, c, h, w)] = x_nchw.data[b][in.index(Layout::NCHW, c, h, w)];
+                }
+            }
+        }
+    }
+
+    Matrix y_nchw = nchw.forward(x_nchw);
+    Matrix y_nhwc = nhwc.forward(x_nhwc);
+    const Shape3& out = nchw.outputShape();
+    assert(out.height == H && out.width == W); // padding 1 keeps the size
+    for (int b = 0; b < 2; ++b) {
+        for (int c = 0; c < OC; ++c) {
+            for (int h = 0; h < H; ++h) {
+                for (int w = 0; w < W; ++w) {
+                    double a = y_nchw.data[b][out.index(Layout::NCHW, c, h, w)];
+                    double d = y_nhwc.data[b][out.index(Layout::NHWC, c, h, w)];
+                    assert(std::abs(a - d) < 1e-9);
+                }
+            }
+        }
+    }
+
+    std::cout << "[PASS] Conv2D NCHW/NHWC agreement test" << std::endl;
+}
+
+void test_conv2d_input_gradient() {
+    // Numerical check of dE/dX with E = sum(output), learning rate 0
+    Conv2D conv(2, 4, 4, 2, 3, 3, 1, 1, Layout::NHWC);
+    Matrix x(1, 32);
+    x.setRandom();
+
+    Matrix y = conv.forward(x);
+    Matrix ones(1, y.cols);
+    for (int j = 0; j < y.cols; ++j) ones.data[0][j] = 1.0;
+    Matrix grad = conv.backward(ones, 0.0);
+
+    const double eps = 1e-6;
+    for (int j = 0; j < x.cols; ++j) {
+        Matrix xp = x, xm = x;
+        xp.data[0][j] += eps;
+        xm.data[0][j] -= eps;
+        double fp = 0, fm = 0;
+        Matrix yp = conv.forward(xp), ym = conv.forward(xm);
+        for (int k = 0; k < y.cols; ++k) {
+            fp += yp.data[0][k];
+            fm += ym.data[0][k];
+        }
+        assert(std::abs((fp - fm) / (2 * eps) - grad.data[0][j]) < 1e-5);
+    }
+
+    std::cout << "[PASS] Conv2D input gradient test" << std::endl;
+}
+
+void test_conv1d_shape() {
+    Conv1D conv(3, 10, 4, 3, 2, 1);
+    Matrix x(5, 30);
+    x.setRandom();
+    Matrix y = conv.forward(x);
+
+    // (10 + 2 - 3) / 2 + 1 = 5 positions, 4 channels
+    assert(conv.outputLength() == 5);
+    assert(y.rows == 5);
+    assert(y.cols == 20);
+    assert(conv.outputSize(30) == 20);
+
+    Matrix g = conv.backward(y, 0.01);
+    assert(g.rows == 5 && g.cols == 30);
+
+    std::cout << "[PASS] Conv1D shape test" << std::endl;
+}
+
+void test_max_pool() {
+    MaxPool pool(1, 4, 4, 2, 2);
+    Matrix x(1, 16);
+    x.data = {{1, 2, 5, 6,
+               3, 4, 7, 8,
+               9, 1, 2, 2,
+               1, 1, 2, 3}};
+
+    Matrix y = pool.forward(x);
+    assert(y.cols == 4);
+    assert(y.data[0][0] == 4);
+    assert(y.data[0][1] == 8);
+    assert(y.data[0][2] == 9);
+    assert(y.data[0][3] == 3);
+
+    Matrix g(1, 4);
+    g.data = {{1, 2, 3, 4}};
+    Matrix dx = pool.backward(g, 0.01);
+    assert(dx.data[0][5] == 1);  // position of 4
+    assert(dx.data[0][7] == 2);  // position of 8
+    assert(dx.data[0][8] == 3);  // position of 9
+    assert(dx.data[0][15] == 4); // position of 3
+    assert(dx.data[0][0] == 0);
+
+    std::cout << "[PASS] MaxPool forward/backward test" << std::endl;
+}
+
+void test_avg_pool() {
+    // Two channels in NHWC, 1D windows of length 2 (height 1)
+    AvgPool pool(2, 1, 4, 1, 2, 0, Layout::NHWC);
+    Matrix x(1, 8);
+    x.data = {{1, 10, 3, 30, 5, 50, 7, 70}};
+
+    Matrix y = pool.forward(x);
+    assert(y.cols == 4);
+    assert(std::abs(y.data[0][0] - 2) < 1e-9);
+    assert(std::abs(y.data[0][1] - 20) < 1e-9);
+    assert(std::abs(y.data[0][2] - 6) < 1e-9);
+    assert(std::abs(y.data[0][3] - 60) < 1e-9);
+
+    Matrix g(1, 4);
+    g.data = {{2, 4, 6, 8}};
+    Matrix dx = pool.backward(g, 0.01);
+    assert(std::abs(dx.data[0][0] - 1) < 1e-9);
+    assert(std::abs(dx.data[0][2] - 1) < 1e-9);
+    assert(std::abs(dx.data[0][7] - 4) < 1e-9);
+
+    std::cout << "[PASS] AvgPool forward/backward test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Convolution and Pooling tests..." << std::endl;
+
+    test_conv2d_forward();
+    test_conv2d_layouts_agree();
+    test_conv2d_input_gradient();
+    test_conv1d_shape();
+    test_max_pool();
+    test_avg_pool();
+
+    std::cout << "\nAll Convolution and Pooling tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "../src/Ensemble.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include "../src/layers/Normalization.h"
+#include "../src/layers/Dropout.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+static Matrix makeInput(int n, int cols) {
+    Matrix X(n, cols);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < cols; ++j) X.data[i][j] = std::sin(0.37 * i + 1.1 * j);
+    return X;
+}
+
+static Network* makeMember(int outputs, bool batch_norm) {
+    Network* net = new Network();
+    net->add(new Dense(3, 6));
+    if (batch_norm) net->add(new BatchNorm(6));
+    net->add(new Tanh());
+    net->add(new Dropout(0.2));
+    net->add(new Dense(6, 4));
+    net->add(new Sigmoid());
+    net->add(new Dense(4, outputs));
+    return net;
+}
+
+void test_member_outputs_match() {
+    Random::seed(11);
+    Ensemble ensemble;
+    for (int m = 0; m < 5; ++m) ensemble.add(makeMember(2, true));
+
+    // Non-trivial running statistics
+    for (size_t m = 0; m < ensemble.size(); ++m) {
+        BatchNorm* bn = static_cast<BatchNorm*>(ensemble.member(m).getLayers()[1]);
+        for (int j = 0; j < 6; ++j) {
+            bn->running_mean.data[0][j] = 0.1 * j - 0.05 * m;
+            bn->running_var.data[0][j] = 0.5 + 0.1 * m;
+        }
+    }
+
+    Matrix X = makeInput(70, 3); // more than two row blocks, last one partial
+    Matrix all = ensemble.predictMembers(X, 1);
+    assert(all.rows == 70 && all.cols == 5 * 2);
+    for (size_t m = 0; m < ensemble.size(); ++m) {
+        Matrix p = ensemble.member(m).predict(X);
+        for (int i = 0; i < 70; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                assert(all.data[i][m * 2 + j] == p.data[i][j]);
+            }
+        }
+    }
+
+    // Thread count does not change the result
+    Matrix threaded = ensemble.predictMembers(X, 4);
+    assert(threaded.data == all.data);
+
+    std::cout << "[PASS] Ensemble member outputs test" << std::endl;
+}
+
+void test_reductions() {
+    Random::seed(12);
+    Ensemble ensemble;
+    for (int m = 0; m < 4; ++m) ensemble.add(makeMember(3, false));
+    Matrix X = makeInput(10, 3);
+    Matrix all = ensemble.predictMembers(X);
+
+    Matrix mean = ensemble.predict(X, EnsembleReduction::Mean);
+    Matrix vote = ensemble.predict(X, EnsembleReduction::Vote);
+    for (int i = 0; i < 10; ++i) {
+        int counts[3] = {0, 0, 0};
+        for (int m = 0; m < 4; ++m) {
+            int best = 0;
+            for (int j = 1; j < 3; ++j) {
+                if (all.data[i][m * 3 + j] > all.data[i][m * 3 + best]) best = j;
+            }
+            counts[best]++;
+        }
+        int winner = 0;
+        for (int j = 1; j < 3; ++j) {
+            if (counts[j] > counts[winner]) winner = j;
+        }
+        for (int j = 0; j < 3; ++j) {
+            double sum = 0.0;
+            for (int m = 0; m < 4; ++m) sum += all.data[i][m * 3 + j];
+            assert(std::abs(mean.data[i][j] - sum / 4) < 1e-15);
+            assert(vote.data[i][j] == (j == winner ? 1.0 : 0.0));
+        }
+    }
+
+    // Binary vote: strict majority of members at >= 0.5
+    Ensemble binary;
+    for (double b : {2.0, 2.0, -2.0}) {
+        Network* net = new Network();
+        Dense* d = new Dense(1, 1);
+        d->weights.data[0][0] = 0.0;
+        d->bias.data[0][0] = b;
+        net->add(d);
+        net->add(new Sigmoid());
+        binary.add(net);
+    }
+    Matrix one(1, 1);
+    assert(binary.predict(one, EnsembleReduction::Vote).data[0][0] == 1.0);
+
+    std::cout << "[PASS] Ensemble reduction test" << std::endl;
+}
+
+void test_topology_mismatch() {
+    Ensemble ensemble;
+    ensemble.add(makeMember(2, false));
+    ensemble.add(makeMember(3, false));
+    bool threw = false;
+    try {
+        ensemble.pack();
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    Ensemble mixed;
+    mixed.add(makeMember(2, false));
+    mixed.add(makeMember(2, true));
+    threw = false;
+    try {
+        mixed.pack();
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "[PASS] Ensemble topology mismatch test" << std::endl;
+}
+
+void test_input_width_rejected() {
+    Random::seed(13);
+    Ensemble ensemble;
+    for (int m = 0; m < 3; ++m) ensemble.add(makeMember(2, false));
+    bool threw = false;
+    try {
+        ensemble.predict(makeInput(4, 5));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        ensemble.predictMembers(makeInput(4, 2));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(ensemble.predict(makeInput(4, 3)).rows == 4);
+
+    std::cout << "[PASS] Ensemble input width rejection test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Ensemble tests..." << std::endl;
+
+    test_member_outputs_match();
+    test_reductions();
+    test_topology_mismatch();
+    test_input_width_rejected();
+
+    std::cout << "\nAll Ensemble tests passed!" << std::endl;
+    return 0;
+}
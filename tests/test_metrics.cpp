@@ -0,0 +1,212 @@
+#include "../src/Network.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include "../src/layers/Conv2D.h"
+#include "TestData.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+void test_binary_metrics() {
+    // targets / predictions
+    double t[] = {1, 1, 1, 0, 0, 0, 1, 0};
+    double p[] = {0.9, 0.7, 0.3, 0.2, 0.6, 0.1, 0.8, 0.4};
+    Metrics m(1);
+    m.add(t, p, 8);
+
+    assert(m.rows() == 8 && m.classes() == 2);
+    // predicted classes: 1 1 0 0 1 0 1 0
+    assert(m.confusion(1, 1) == 3 && m.confusion(1, 0) == 1);
+    assert(m.confusion(0, 0) == 3 && m.confusion(0, 1) == 1);
+    assert(m.accuracy() == 0.75);
+    assert(std::abs(m.precision(1) - 0.75) < 1e-12);
+    assert(std::abs(m.recall(1) - 0.75) < 1e-12);
+
+    double abs_sum = 0.1 + 0.3 + 0.7 + 0.2 + 0.6 + 0.1 + 0.2 + 0.4;
+    assert(std::abs(m.mae() - abs_sum / 8) < 1e-12);
+
+    // AUC by pairs: positives {0.9, 0.7, 0.3, 0.8} vs negatives {0.2, 0.6, 0.1, 0.4}
+    int wins = 0;
+    for (int i = 0; i < 8; ++i)
+        for (int j = 0; j < 8; ++j)
+            if (t[i] == 1 && t[j] == 0 && p[i] > p[j]) wins++;
+    assert(std::abs(m.rocAuc() - wins / 16.0) < 1e-12);
+
+    std::cout << "[PASS] Binary metrics test" << std::endl;
+}
+
+void test_multiclass_metrics() {
+    // one-hot targets, three classes
+    double t[] = {1, 0, 0,  0, 1, 0,  0, 0, 1,  0, 0, 1};
+    double p[] = {0.8, 0.1, 0.1,  0.3, 0.6, 0.1,  0.5, 0.2, 0.3,  0.1, 0.1, 0.8};
+    Metrics m(3);
+    m.add(t, p, 4);
+
+    assert(m.classes() == 3);
+    assert(m.confusion(0, 0) == 1 && m.confusion(1, 1) == 1 && m.confusion(2, 0) == 1 && m.confusion(2, 2) == 1);
+    assert(m.accuracy() == 0.75);
+    assert(std::abs(m.precision(0) - 0.5) < 1e-12);
+    assert(std::abs(m.recall(2) - 0.5) < 1e-12);
+    assert(std::abs(m.macroRecall() - (1.0 + 1.0 + 0.5) / 3) < 1e-12);
+
+    std::cout << "[PASS] Multi-class metrics test" << std::endl;
+}
+
+void test_merge() {
+    const int n = 1000;
+    std::vector<double> t(n), p(n);
+    for (int i = 0; i < n; ++i) {
+        t[i] = (i % 3 == 0) ? 1.0 : 0.0;
+        p[i] = 0.5 + 0.5 * std::sin(0.01 * i * i);
+    }
+
+    Metrics whole(1);
+    whole.add(t.data(), p.data(), n);
+    Metrics a(1), b(1);
+    a.add(t.data(), p.data(), 337);
+    b.add(t.data() + 337, p.data() + 337, n - 337);
+    a.merge(b);
+
+    assert(a.rows() == whole.rows());
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j) assert(a.confusion(i, j) == whole.confusion(i, j));
+    assert(a.rocAuc() == whole.rocAuc());
+    assert(std::abs(a.mae() - whole.mae()) < 1e-12);
+
+    std::cout << "[PASS] Metrics merge test" << std::endl;
+}
+
+static void buildNet(Network& net) {
+    Random::seed(5);
+    net.add(new Dense(2, 8));
+    net.add(new Tanh());
+    net.add(new Dense(8, 1));
+    net.add(new Sigmoid());
+}
+
+void test_network_evaluate() {
+    Network net;
+    buildNet(net);
+    Matrix X(1000, 2), Y(1000, 1);
+    makeRows(0, 1000, X, Y);
+
+    // Reference: one monolithic predict
+    Matrix p = net.predict(X);
+    int correct = 0;
+    double abs_error = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        correct += ((p.data[i][0] >= 0.5) == (Y.data[i][0] >= 0.5));
+        abs_error += std::abs(p.data[i][0] - Y.data[i][0]);
+    }
+
+    EvaluationOptions options;
+    options.chunk_rows = 64;
+    for (int threads : {1, 3}) {
+        options.threads = threads;
+        Metrics m = net.evaluate(X, Y, options);
+        assert(m.rows() == 1000);
+        assert(m.confusion(0, 0) + m.confusion(1, 1) == (uint64_t)correct);
+        assert(std::abs(m.mae() - abs_error / 1000) < 1e-12);
+    }
+
+    // Streaming source: the same rows generated on demand
+    options.threads = 3;
+    Metrics streamed = net.evaluate(1000, makeRows, options);
+    Metrics direct = net.evaluate(X, Y, options);
+    assert(streamed.accuracy() == direct.accuracy());
+    assert(streamed.rocAuc() == direct.rocAuc());
+
+    // A compiled plan of the chunk size is reused; any other size is not
+    for (int batch : {64, 100}) {
+        net.compile(batch);
+        Metrics compiled = net.evaluate(X, Y, options);
+        assert(compiled.accuracy() == direct.accuracy() && compiled.mae() == direct.mae());
+        assert(net.evaluate(1000, makeRows, options).rocAuc() == direct.rocAuc());
+    }
+
+    std::cout << "[PASS] Network evaluate test" << std::endl;
+}
+
+void test_evaluate_large_stream() {
+    Network net;
+    buildNet(net);
+
+    // 2M rows, never more than one chunk per thread in memory
+    EvaluationOptions options;
+    options.chunk_rows = 8192;
+    Metrics m = net.evaluate(2000000, makeRows, options);
+    assert(m.rows() == 2000000);
+    uint64_t total = 0;
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j) total += m.confusion(i, j);
+    assert(total == 2000000);
+
+    std::cout << "[PASS] Large streamed evaluation test" << std::endl;
+}
+
+void test_non_reentrant_network() {
+    // Conv2D goes through Layer::forward, so evaluation runs on one thread
+    Random::seed(6);
+    Network net;
+    net.add(new Conv2D(1, 3, 3, 2, 2, 2));
+    net.add(new Tanh());
+    net.add(new Dense(8, 1));
+    net.add(new Sigmoid());
+
+    Matrix X(100, 9), Y(100, 1);
+    for (int i = 0; i < 100; ++i) {
+        for (int j = 0; j < 9; ++j) X.data[i][j] = std::sin(0.3 * i + j);
+        Y.data[i][0] = i % 2;
+    }
+    EvaluationOptions options;
+    options.chunk_rows = 16;
+    options.threads = 4;
+    Metrics m = net.evaluate(X, Y, options);
+
+    Matrix p = net.predict(X);
+    double abs_error = 0.0;
+    for (int i = 0; i < 100; ++i) abs_error += std::abs(p.data[i][0] - Y.data[i][0]);
+    assert(std::abs(m.mae() - abs_error / 100) < 1e-12);
+
+    std::cout << "[PASS] Non-reentrant network evaluation test" << std::endl;
+}
+
+void test_evaluate_shape_mismatch_rejected() {
+    Network net;
+    buildNet(net);
+    Matrix X(50, 2), Y(50, 1);
+    makeRows(0, 50, X, Y);
+    auto throws = [](const std::function<void()>& f) {
+        try {
+            f();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    assert(throws([&]() { net.evaluate(X, Matrix(49, 1)); }));
+    assert(throws([&]() { net.evaluate(X, Matrix(50, 2)); }));
+    assert(throws([&]() { net.evaluate(Matrix(50, 3), Y); }));
+    net.compile(4096); // the reused compiled plan is checked the same way
+    assert(throws([&]() { net.evaluate(X, Matrix(50, 2)); }));
+    assert(!throws([&]() { net.evaluate(X, Y); }));
+
+    std::cout << "[PASS] Evaluate shape mismatch rejection test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Metrics tests..." << std::endl;
+
+    test_binary_metrics();
+    test_multiclass_metrics();
+    test_merge();
+    test_network_evaluate();
+    test_evaluate_large_stream();
+    test_non_reentrant_network();
+    test_evaluate_shape_mismatch_rejected();
+
+    std::cout << "\nAll Metrics tests passed!" << std::endl;
+    return 0;
+}
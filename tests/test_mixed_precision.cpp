@@ -0,0 +1,122 @@
+#include "../src/MixedPrecision.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include "../src/losses/MSE.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+void test_bf16_conversion() {
+    assert(half::bf16ToFloat(half::floatToBf16(1.0f)) == 1.0f);
+    assert(half::bf16ToFloat(half::floatToBf16(-2.5f)) == -2.5f);
+
+    // 8 mantissa bits: relative error below 2^-9
+    float pi = 3.14159265f;
+    assert(std::abs(half::bf16ToFloat(half::floatToBf16(pi)) - pi) / pi < 1.0f / 512);
+
+    // 1 + 2^-8 is exactly halfway between two bf16 values: ties go to even (1.0)
+    assert(half::bf16ToFloat(half::floatToBf16(1.0f + 1.0f / 256)) == 1.0f);
+
+    // Same exponent range as fp32
+    assert(half::bf16ToFloat(half::floatToBf16(1e30f)) > 9e29f);
+    assert(std::isinf(half::bf16ToFloat(half::floatToBf16(std::numeric_limits<float>::infinity()))));
+    assert(std::isnan(half::bf16ToFloat(half::floatToBf16(std::numeric_limits<float>::quiet_NaN()))));
+
+    std::cout << "[PASS] bf16 conversion test" << std::endl;
+}
+
+void test_fp16_conversion() {
+    assert(half::fp16ToFloat(half::floatToFp16(1.0f)) == 1.0f);
+    assert(std::abs(half::fp16ToFloat(half::floatToFp16(0.333333f)) - 0.333333f) < 1e-3f);
+    assert(half::floatToFp16(65504.0f) == 0x7BFF);              // largest half
+    assert(std::isinf(half::fp16ToFloat(half::floatToFp16(70000.0f))));
+    assert(half::fp16ToFloat(half::floatToFp16(std::ldexp(1.0f, -24))) == std::ldexp(1.0f, -24)); // smallest subnormal
+    assert(half::floatToFp16(std::ldexp(1.0f, -26)) == 0);       // underflows to zero
+    assert(half::fp16ToFloat(half::floatToFp16(-6.103515625e-05f)) == -6.103515625e-05f); // smallest normal
+
+    std::cout << "[PASS] fp16 conversion test" << std::endl;
+}
+
+void test_loss_scaler() {
+    LossScaler scaler(1024.0f, 3);
+    assert(!scaler.update(true));
+    assert(scaler.scale == 512.0f);
+    assert(scaler.skipped_steps == 1);
+    assert(scaler.update(false));
+    assert(scaler.update(false));
+    assert(scaler.update(false));
+    assert(scaler.scale == 1024.0f);
+
+    std::cout << "[PASS] Loss scaler test" << std::endl;
+}
+
+static void buildXor(Network& net, Matrix& X, Matrix& Y) {
+    X = Matrix(4, 2);
+    X.data = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    Y = Matrix(4, 1);
+    Y.data = {{0}, {1}, {1}, {0}};
+    net.add(new Dense(2, 8));
+    net.add(new Tanh());
+    net.add(new Dense(8, 1));
+    net.add(new Sigmoid());
+}
+
+void test_mixed_precision_training() {
+    for (HalfFormat format : {HalfFormat::BF16, HalfFormat::FP16}) {
+        Network net;
+        Matrix X, Y;
+        buildXor(net, X, Y);
+
+        MixedPrecisionTrainer trainer(net, format, LossScaler(1024.0f));
+        double initial = MSE::loss(Y, trainer.predict(X));
+        double final_loss = trainer.train(X, Y, 3000, 0.5);
+        assert(final_loss < initial);
+
+        // Master weights were synced back: the fp64 network agrees with the
+        // 16-bit forward pass up to 16-bit rounding
+        Matrix p16 = trainer.predict(X);
+        Matrix p64 = net.predict(X);
+        for (int i = 0; i < 4; ++i) {
+            assert(std::abs(p16.data[i][0] - p64.data[i][0]) < 0.05);
+        }
+    }
+
+    std::cout << "[PASS] Mixed precision training test" << std::endl;
+}
+
+void test_overflow_skips_step() {
+    Network net;
+    Matrix X, Y;
+    buildXor(net, X, Y);
+
+    // A scale this large overflows fp16 immediately and has to back off
+    MixedPrecisionTrainer trainer(net, HalfFormat::FP16, LossScaler(1e9f));
+    trainer.train(X, Y, 50, 0.1);
+    assert(trainer.getScaler().skipped_steps > 0);
+    assert(trainer.getScaler().scale < 1e9f);
+
+    Matrix p = net.predict(X);
+    for (int i = 0; i < 4; ++i) {
+        assert(std::isfinite(p.data[i][0]));
+    }
+
+    // 16-bit storage is a quarter of the fp64 footprint
+    size_t elements = 4 * (2 + 8 + 8 + 1 + 1) + (2 * 8 + 8 * 1);
+    assert(trainer.workingSetBytes(4) == elements * 2);
+
+    std::cout << "[PASS] Loss scaling overflow test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Mixed precision tests..." << std::endl;
+
+    test_bf16_conversion();
+    test_fp16_conversion();
+    test_loss_scaler();
+    test_mixed_precision_training();
+    test_overflow_skips_step();
+
+    std::cout << "\nAll Mixed precision tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "../src/Network.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include "../src/layers/Normalization.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+void test_batchnorm_training_forward() {
+    BatchNorm bn(2);
+    bn.setTraining(true);
+
+    Matrix x(4, 2);
+    x.data = {{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+    Matrix y = bn.forward(x);
+
+    for (int j = 0; j < 2; ++j) {
+        double mean = 0, sq = 0;
+        for (int i = 0; i < 4; ++i) {
+            mean += y.data[i][j];
+            sq += y.data[i][j] * y.data[i][j];
+        }
+        assert(std::abs(mean / 4) < 1e-9);
+        assert(std::abs(sq / 4 - 1.0) < 1e-3);
+    }
+    // Running mean moved 10% towards the batch mean (2.5, 25)
+    assert(std::abs(bn.running_mean.data[0][0] - 0.25) < 1e-9);
+    assert(std::abs(bn.running_mean.data[0][1] - 2.5) < 1e-9);
+
+    std::cout << "[PASS] BatchNorm training forward test" << std::endl;
+}
+
+void test_batchnorm_input_gradient() {
+    BatchNorm bn(3);
+    bn.setTraining(true);
+    bn.gamma.data = {{1.5, 0.5, 2.0}};
+
+    Matrix x(5, 3);
+    x.setRandom();
+    Matrix w(5, 3); // E = sum(w * y) makes the gradient non-trivial
+    w.setRandom();
+
+    auto energy = [&](const Matrix& in) {
+        Matrix y = bn.forward(in);
+        double e = 0;
+        for (int i = 0; i < 5; ++i)
+            for (int j = 0; j < 3; ++j) e += w.data[i][j] * y.data[i][j];
+        return e;
+    };
+
+    bn.forward(x);
+    Matrix grad = bn.backward(w, 0.0);
+
+    const double eps = 1e-6;
+    for (int i = 0; i < 5; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            Matrix xp = x, xm = x;
+            xp.data[i][j] += eps;
+            xm.data[i][j] -= eps;
+            double numeric = (energy(xp) - energy(xm)) / (2 * eps);
+            assert(std::abs(numeric - grad.data[i][j]) < 1e-5);
+        }
+    }
+
+    std::cout << "[PASS] BatchNorm input gradient test" << std::endl;
+}
+
+void test_layernorm_forward_and_gradient() {
+    LayerNorm ln(4);
+    Matrix x(2, 4);
+    x.data = {{1, 2, 3, 4}, {-5, 0, 5, 10}};
+    Matrix y = ln.forward(x);
+
+    for (int i = 0; i < 2; ++i) {
+        double mean = 0;
+        for (int j = 0; j < 4; ++j) mean += y.data[i][j];
+        assert(std::abs(mean / 4) < 1e-9);
+    }
+
+    Matrix w(2, 4);
+    w.data = {{0.3, -1, 2, 0.5}, {1, 1, -2, 0.1}};
+    Matrix grad = ln.backward(w, 0.0);
+
+    const double eps = 1e-6;
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            Matrix xp = x, xm = x;
+            xp.data[i][j] += eps;
+            xm.data[i][j] -= eps;
+            Matrix yp = ln.forward(xp), ym = ln.forward(xm);
+            double numeric = 0;
+            for (int k = 0; k < 4; ++k) numeric += w.data[i][k] * (yp.data[i][k] - ym.data[i][k]);
+            numeric /= 2 * eps;
+            assert(std::abs(numeric - grad.data[i][j]) < 1e-5);
+        }
+    }
+
+    std::cout << "[PASS] LayerNorm forward/gradient test" << std::endl;
+}
+
+void test_fold_batchnorm() {
+    Network net;
+    Dense* dense = new Dense(3, 4);
+    BatchNorm* bn = new BatchNorm(4);
+    net.add(dense);
+    net.add(bn);
+    net.add(new Tanh());
+    net.add(new Dense(4, 1));
+
+    Matrix X(8, 3);
+    X.setRandom();
+    Matrix Y(8, 1);
+    for (int i = 0; i < 8; ++i) Y.data[i][0] = X.data[i][0] > 0 ? 1 : 0;
+
+    net.train(X, Y, 20, 0.05); // gives BatchNorm non-trivial statistics
+    Matrix before = net.predict(X);
+
+    assert(net.foldBatchNorm() == 1);
+    Matrix after = net.predict(X);
+    for (int i = 0; i < 8; ++i) {
+        assert(std::abs(before.data[i][0] - after.data[i][0]) < 1e-9);
+    }
+
+    net.compileForInference(8);
+    assert(net.getPlan()->getSteps().size() == 3);
+
+    std::cout << "[PASS] BatchNorm folding test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Normalization tests..." << std::endl;
+
+    test_batchnorm_training_forward();
+    test_batchnorm_input_gradient();
+    test_layernorm_forward_and_gradient();
+    test_fold_batchnorm();
+
+    std::cout << "\nAll Normalization tests passed!" << std::endl;
+    return 0;
+}
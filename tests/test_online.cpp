@@ -0,0 +1,263 @@
+#include "../src/OnlineLearner.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include "../src/layers/Normalization.h"
+#include "../src/layers/Dropout.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static void buildSmall(Network& net) {
+    net.add(new Dense(4, 12));
+    net.add(new Tanh());
+    net.add(new Dense(12, 1));
+    net.add(new Sigmoid());
+}
+
+// Target is x0 > x1 (concept A) or x0 < x1 (concept B)
+static void makeStream(int n, bool flipped, int offset, Matrix& X, Matrix& Y) {
+    X = Matrix(n, 4);
+    Y = Matrix(n, 1);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < 4; ++j) X.data[i][j] = std::sin(0.71 * (i + offset) + 1.9 * j);
+        bool above = X.data[i][0] > X.data[i][1];
+        Y.data[i][0] = (above != flipped) ? 1.0 : 0.0;
+    }
+}
+
+static Matrix rows(const Matrix& m, int row0, int n) {
+    Matrix out(n, m.cols);
+    for (int i = 0; i < n; ++i) out.data[i] = m.data[row0 + i];
+    return out;
+}
+
+void test_initial_snapshot() {
+    Random::seed(5);
+    Network model;
+    buildSmall(model);
+    Matrix X, Y;
+    makeStream(40, false, 0, X, Y);
+    Matrix expected = model.predict(X);
+
+    OnlineLearner learner(buildSmall, model.saveParameters());
+    assert(learner.version() == 0 && learner.inputSize() == 4 && learner.outputSize() == 1);
+    uint64_t version = 99;
+    Matrix actual = learner.predict(X, &version);
+    assert(version == 0);
+    for (int i = 0; i < X.rows; ++i) assert(actual.data[i][0] == expected.data[i][0]);
+
+    std::cout << "[PASS] Initial snapshot test" << std::endl;
+}
+
+void test_training_matches_minibatch_sgd() {
+    Random::seed(6);
+    Network reference;
+    buildSmall(reference);
+    std::vector<Matrix> initial = reference.saveParameters();
+
+    OnlineOptions options;
+    options.batch_rows = 8;
+    options.learning_rate = 0.2;
+    options.publish_every = 3;
+    OnlineLearner learner(buildSmall, initial, options);
+
+    // 100 rows in uneven pieces: 12 full batches and a partial one of 4
+    Matrix X, Y;
+    makeStream(100, false, 0, X, Y);
+    learner.start();
+    for (int row0 = 0; row0 < X.rows;) {
+        int n = std::min(1 + row0 % 7, X.rows - row0);
+        while (!learner.submit(rows(X, row0, n), rows(Y, row0, n))) std::this_thread::yield();
+        row0 += n;
+    }
+    learner.stop();
+    assert(learner.samplesSeen() == 100 && learner.steps() == 13);
+    assert(learner.version() == 5); // after steps 3, 6, 9, 12 and the final one
+
+    reference.compile(options.batch_rows);
+    for (int row0 = 0; row0 < X.rows; row0 += options.batch_rows) {
+        int n = std::min(options.batch_rows, X.rows - row0);
+        reference.train(rows(X, row0, n), rows(Y, row0, n), 1, options.learning_rate);
+    }
+    std::vector<Matrix> expected = reference.saveParameters();
+    uint64_t version = 0;
+    std::vector<Matrix> actual = learner.parameters(&version);
+    assert(version == 5 && actual.size() == expected.size());
+    for (size_t p = 0; p < actual.size(); ++p)
+        for (int i = 0; i < actual[p].rows; ++i)
+            for (int j = 0; j < actual[p].cols; ++j) assert(actual[p].data[i][j] == expected[p].data[i][j]);
+
+    std::cout << "[PASS] Streamed training vs mini-batch SGD test" << std::endl;
+}
+
+void test_adapts_to_drift() {
+    Random::seed(7);
+    Network model;
+    buildSmall(model);
+    Matrix X, Y;
+    makeStream(200, false, 0, X, Y);
+    model.train(X, Y, 300, 0.5);
+
+    Matrix Xb, Yb;
+    makeStream(200, true, 1000, Xb, Yb);
+    auto error = [&](const Matrix& prediction) {
+        double sum = 0.0;
+        for (int i = 0; i < Yb.rows; ++i) sum += (prediction.data[i][0] - Yb.data[i][0]) * (prediction.data[i][0] - Yb.data[i][0]);
+        return sum / Yb.rows;
+    };
+
+    OnlineOptions options;
+    options.batch_rows = 16;
+    options.learning_rate = 0.5;
+    OnlineLearner learner(buildSmall, model.saveParameters(), options);
+    double before = error(learner.predict(Xb));
+    learner.start();
+    for (int pass = 0; pass < 40; ++pass) {
+        Matrix Xs, Ys;
+        makeStream(50, true, pass * 50, Xs, Ys);
+        while (!learner.submit(Xs, Ys)) std::this_thread::yield();
+    }
+    learner.stop();
+    double after = error(learner.predict(Xb));
+    assert(after < before * 0.5);
+
+    std::cout << "[PASS] Adaptation to concept drift test" << std::endl;
+}
+
+void test_concurrent_readers() {
+    Random::seed(8);
+    OnlineOptions options;
+    options.batch_rows = 4;
+    options.publish_every = 1; // a new snapshot after every step
+    options.serve_batch_rows = 16;
+    OnlineLearner learner(buildSmall, {}, options);
+
+    // 64 identical rows span four plan blocks: a call that mixed snapshots
+    // would return different values across rows
+    Matrix probe(64, 4);
+    for (int i = 0; i < 64; ++i) probe.data[i] = {0.3, -0.2, 0.5, 0.1};
+
+    std::atomic<bool> done{false};
+    std::atomic<long> calls{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&]() {
+            uint64_t last = 0;
+            while (!done.load()) {
+                uint64_t version = 0;
+                Matrix out = learner.predict(probe, &version);
+                assert(version >= last);
+                last = version;
+                for (int i = 1; i < 64; ++i) assert(out.data[i][0] == out.data[0][0]);
+                assert(std::isfinite(out.data[0][0]));
+                calls++;
+            }
+        });
+    }
+
+    learner.start();
+    Matrix X, Y;
+    makeStream(400, false, 0, X, Y);
+    for (int row0 = 0; row0 < X.rows; row0 += 2) {
+        while (!learner.submit(rows(X, row0, 2), rows(Y, row0, 2))) std::this_thread::yield();
+    }
+    learner.stop();
+    done = true;
+    for (std::thread& t : readers) t.join();
+    assert(learner.version() == 100 && calls > 0);
+
+    std::cout << "[PASS] Concurrent readers during hot-swap test" << std::endl;
+}
+
+void test_publish_leaves_random_streams_alone() {
+    Random::seed(9);
+    int builds = 0;
+    OnlineOptions options;
+    options.batch_rows = 4;
+    options.publish_every = 1;
+    OnlineLearner learner([&](Network& net) {
+        ++builds;
+        buildSmall(net);
+    }, {}, options);
+    uint64_t before = Random::nextStream();
+
+    Matrix X, Y;
+    makeStream(40, false, 0, X, Y);
+    learner.start();
+    while (!learner.submit(X, Y)) std::this_thread::yield();
+    learner.stop();
+    assert(learner.version() == 10);
+    // Snapshots are copies: no layer was constructed on the trainer thread
+    assert(builds == 1);
+    assert(Random::nextStream() == before + 1);
+
+    // The served snapshot is exactly the trained weights
+    Network copy;
+    buildSmall(copy);
+    copy.loadParameters(learner.parameters());
+    std::unique_ptr<Network> clone = copy.clone();
+    Matrix expected = learner.predict(X);
+    Matrix actual = clone->predict(X);
+    for (int i = 0; i < X.rows; ++i) assert(actual.data[i][0] == expected.data[i][0]);
+
+    std::cout << "[PASS] Snapshot publishing without rebuilding test" << std::endl;
+}
+
+void test_rejections() {
+    OnlineLearner learner(buildSmall);
+    bool threw = false;
+    try {
+        learner.submit(Matrix(2, 3), Matrix(2, 1));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        learner.predict(Matrix(2, 5));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Dropout cannot be served through a reentrant plan
+    threw = false;
+    try {
+        OnlineLearner dropout([](Network& net) {
+            net.add(new Dense(4, 8));
+            net.add(new Dropout(0.5));
+            net.add(new Dense(8, 1));
+        });
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // BatchNorm after Dense is folded away and served
+    OnlineLearner folded([](Network& net) {
+        net.add(new Dense(4, 8));
+        net.add(new BatchNorm(8));
+        net.add(new Tanh());
+        net.add(new Dense(8, 1));
+    });
+    assert(folded.predict(Matrix(3, 4)).rows == 3);
+
+    std::cout << "[PASS] Unsupported model rejection test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running OnlineLearner tests..." << std::endl;
+
+    test_initial_snapshot();
+    test_training_matches_minibatch_sgd();
+    test_adapts_to_drift();
+    test_concurrent_readers();
+    test_publish_leaves_random_streams_alone();
+    test_rejections();
+
+    std::cout << "\nAll OnlineLearner tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,277 @@
+#include "../src/Pipeline.h"
+#include "../src/Parallel.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include "../src/layers/Normalization.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+static void buildDeep(Network& net, unsigned seed) {
+    Random::seed(seed);
+    net.add(new Dense(6, 16));
+    net.add(new Tanh());
+    net.add(new Dense(16, 16));
+    net.add(new Tanh());
+    net.add(new Dense(16, 8));
+    net.add(new Tanh());
+    net.add(new Dense(8, 2));
+    net.add(new Sigmoid());
+}
+
+static void makeData(int n, Matrix& X, Matrix& Y) {
+    X = Matrix(n, 6);
+    Y = Matrix(n, 2);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < 6; ++j) X.data[i][j] = std::sin(0.37 * i + 1.3 * j);
+        Y.data[i][0] = X.data[i][0] * X.data[i][1] > 0 ? 1.0 : 0.0;
+        Y.data[i][1] = X.data[i][2] > 0 ? 1.0 : 0.0;
+    }
+}
+
+void test_spsc_queue() {
+    parallel::SpscQueue<int> small(3); // rounded up to 4
+    int v = 1;
+    for (int i = 0; i < 4; ++i) {
+        v = i;
+        assert(small.tryPush(v));
+    }
+    assert(!small.tryPush(v));
+    int out = -1;
+    for (int i = 0; i < 4; ++i) {
+        assert(small.tryPop(out) && out == i);
+    }
+    assert(!small.tryPop(out));
+
+    // Producer and consumer on different threads, values arrive in order
+    parallel::SpscQueue<long> queue(64);
+    const long count = 200000;
+    std::thread producer([&]() {
+        for (long i = 0; i < count; ++i) queue.push(i);
+    });
+    long sum = 0;
+    for (long i = 0; i < count; ++i) {
+        long value = queue.pop();
+        assert(value == i);
+        sum += value;
+    }
+    producer.join();
+    assert(sum == count * (count - 1) / 2);
+
+    std::cout << "[PASS] SPSC queue test" << std::endl;
+}
+
+void test_partition() {
+    Network net;
+    buildDeep(net, 1);
+    for (int stages = 1; stages <= 8; ++stages) {
+        Pipeline pipeline(net, stages, 4);
+        const std::vector<int>& b = pipeline.boundaries();
+        assert((int)b.size() == stages + 1 && b.front() == 0 && b.back() == 8);
+        for (int s = 0; s < stages; ++s) assert(b[s] < b[s + 1]);
+    }
+    // The two 16-wide Dense layers dominate and end up in different stages
+    Pipeline two(net, 2, 4);
+    assert(two.boundaries()[1] == 3);
+
+    bool threw = false;
+    try {
+        Pipeline too_many(net, 9, 4);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "[PASS] Stage partition test" << std::endl;
+}
+
+void test_predict_matches_network() {
+    Network net;
+    buildDeep(net, 2);
+    Matrix X, Y;
+    makeData(53, X, Y);
+    Matrix expected = net.predict(X);
+    for (int stages : {1, 2, 3, 4}) {
+        Pipeline pipeline(net, stages, 8); // 53 rows: the last micro-batch is partial
+        Matrix actual = pipeline.predict(X);
+        for (int i = 0; i < X.rows; ++i)
+            for (int j = 0; j < 2; ++j) assert(actual.data[i][j] == expected.data[i][j]);
+    }
+
+    std::cout << "[PASS] Pipelined predict test" << std::endl;
+}
+
+void test_training_matches_full_batch() {
+    Matrix X, Y;
+    makeData(50, X, Y);
+
+    Network reference;
+    buildDeep(reference, 3);
+    for (int e = 0; e < 5; ++e) reference.train(X, Y, 1, 0.3);
+
+    for (int stages : {1, 2, 4}) {
+        Network net;
+        buildDeep(net, 3);
+        Pipeline pipeline(net, stages, 7);
+        pipeline.train(X, Y, 5, 0.3);
+
+        const std::vector<Layer*>& a = reference.getLayers();
+        const std::vector<Layer*>& b = net.getLayers();
+        for (size_t l = 0; l < a.size(); ++l) {
+            std::vector<Matrix*> pa = a[l]->parameters(), pb = b[l]->parameters();
+            for (size_t p = 0; p < pa.size(); ++p)
+                for (int i = 0; i < pa[p]->rows; ++i)
+                    for (int j = 0; j < pa[p]->cols; ++j)
+                        assert(std::abs(pa[p]->data[i][j] - pb[p]->data[i][j]) < 1e-12);
+        }
+    }
+
+    std::cout << "[PASS] Pipelined training vs full-batch step test" << std::endl;
+}
+
+void test_loss_decreases() {
+    Matrix X, Y;
+    makeData(128, X, Y);
+    Network net;
+    buildDeep(net, 4);
+    Pipeline pipeline(net, 3, 16);
+    double first = pipeline.trainStep(X, Y, 0.5);
+    double last = pipeline.train(X, Y, 200, 0.5);
+    assert(last < first);
+
+    std::cout << "[PASS] Pipelined training convergence test" << std::endl;
+}
+
+void test_batchnorm_rejected_for_training() {
+    Network net;
+    net.add(new Dense(6, 4));
+    net.add(new BatchNorm(4));
+    net.add(new Tanh());
+    Pipeline pipeline(net, 2, 4);
+    Matrix X, Y;
+    makeData(8, X, Y);
+    pipeline.predict(X); // inference is fine
+
+    bool threw = false;
+    try {
+        pipeline.trainStep(X, Matrix(8, 4), 0.1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "[PASS] BatchNorm training rejection test" << std::endl;
+}
+
+void test_shape_mismatch_rejected() {
+    Network net;
+    buildDeep(net, 6);
+    Pipeline pipeline(net, 2, 4);
+    Matrix X, Y;
+    makeData(8, X, Y);
+    auto throws = [](const std::function<void()>& f) {
+        try {
+            f();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    assert(throws([&]() { pipeline.predict(Matrix(8, 5)); }));
+    assert(throws([&]() { pipeline.trainStep(Matrix(8, 5), Y, 0.1); }));
+    assert(throws([&]() { pipeline.trainStep(X, Matrix(8, 3), 0.1); }));
+    assert(throws([&]() { pipeline.trainStep(X, Matrix(7, 2), 0.1); }));
+    assert(!throws([&]() { pipeline.trainStep(X, Y, 0.1); }));
+
+    std::cout << "[PASS] Shape mismatch rejection test" << std::endl;
+}
+
+void test_empty_input() {
+    Network net;
+    buildDeep(net, 7);
+    Pipeline pipeline(net, 3, 4);
+    std::vector<Matrix> before = net.saveParameters();
+
+    Matrix out = pipeline.predict(Matrix(0, 6));
+    assert(out.rows == 0 && out.cols == 2);
+    assert(pipeline.trainStep(Matrix(0, 6), Matrix(0, 2), 0.1) == 0.0);
+    std::vector<Matrix> after = net.saveParameters();
+    for (size_t p = 0; p < before.size(); ++p)
+        for (int i = 0; i < before[p].rows; ++i) assert(after[p].data[i] == before[p].data[i]);
+
+    // Still usable afterwards
+    Matrix X, Y;
+    makeData(8, X, Y);
+    assert(pipeline.predict(X).rows == 8);
+
+    std::cout << "[PASS] Empty input test" << std::endl;
+}
+
+// Passes values through, but throws on the first forward once armed
+class FailingLayer : public Layer {
+public:
+    bool armed = false;
+    Matrix forward(const Matrix& input) override {
+        if (armed) {
+            armed = false;
+            throw std::runtime_error("layer failure");
+        }
+        return input;
+    }
+    Matrix backward(const Matrix& grad, double) override { return grad; }
+};
+
+void test_stage_exception_propagates() {
+    Network net;
+    buildDeep(net, 5);
+    FailingLayer* failing = new FailingLayer();
+    net.add(failing);
+    Matrix X, Y;
+    makeData(40, X, Y);
+    Matrix expected = net.predict(X);
+
+    Pipeline pipeline(net, 4, 5); // the failing layer is in the last stage, a worker thread
+    assert(pipeline.boundaries()[3] < 8);
+    std::vector<Matrix> before = net.saveParameters();
+    for (int call = 0; call < 2; ++call) {
+        failing->armed = true;
+        bool threw = false;
+        try {
+            if (call == 0) pipeline.predict(X);
+            else pipeline.trainStep(X, Y, 0.5);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    // The failed step left the weights alone and the pipeline still works
+    std::vector<Matrix> after = net.saveParameters();
+    for (size_t p = 0; p < before.size(); ++p)
+        for (int i = 0; i < before[p].rows; ++i)
+            for (int j = 0; j < before[p].cols; ++j) assert(after[p].data[i][j] == before[p].data[i][j]);
+    Matrix actual = pipeline.predict(X);
+    for (int i = 0; i < X.rows; ++i)
+        for (int j = 0; j < 2; ++j) assert(actual.data[i][j] == expected.data[i][j]);
+
+    std::cout << "[PASS] Stage exception propagation test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Pipeline tests..." << std::endl;
+
+    test_spsc_queue();
+    test_partition();
+    test_predict_matches_network();
+    test_training_matches_full_batch();
+    test_loss_decreases();
+    test_batchnorm_rejected_for_training();
+    test_stage_exception_propagates();
+    test_shape_mismatch_rejected();
+    test_empty_input();
+
+    std::cout << "\nAll Pipeline tests passed!" << std::endl;
+    return 0;
+}
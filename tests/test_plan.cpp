@@ -0,0 +1,127 @@
+#include "../src/Network.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+// Builds two networks with identical weights so the compiled and the
+// interpreted paths can be compared on the same starting point.
+static void buildPair(Network& a, Network& b, int in, int hidden, int out) {
+    Dense* a1 = new Dense(in, hidden);
+    Dense* a2 = new Dense(hidden, out);
+    Dense* b1 = new Dense(in, hidden);
+    Dense* b2 = new Dense(hidden, out);
+    b1->weights = a1->weights;
+    b2->weights = a2->weights;
+    a1->bias.data = {std::vector<double>(hidden, 0.1)};
+    b1->bias = a1->bias;
+
+    a.add(a1); a.add(new Tanh()); a.add(a2); a.add(new Sigmoid());
+    b.add(b1); b.add(new Tanh()); b.add(b2); b.add(new Sigmoid());
+}
+
+static double maxDiff(const Matrix& A, const Matrix& B) {
+    assert(A.rows == B.rows && A.cols == B.cols);
+    double diff = 0;
+    for (int i = 0; i < A.rows; ++i) {
+        for (int j = 0; j < A.cols; ++j) {
+            diff = std::max(diff, std::abs(A.data[i][j] - B.data[i][j]));
+        }
+    }
+    return diff;
+}
+
+void test_plan_predict_matches_interpreter() {
+    Network interpreted, compiled;
+    buildPair(interpreted, compiled, 5, 8, 2);
+    compiled.compile(4);
+
+    Matrix X(10, 5); // more rows than the batch: exercises chunking
+    X.setRandom();
+
+    Matrix expected = interpreted.predict(X);
+    Matrix actual = compiled.predict(X);
+
+    assert(actual.rows == 10);
+    assert(actual.cols == 2);
+    assert(maxDiff(expected, actual) < 1e-12);
+
+    std::cout << "[PASS] Compiled predict matches interpreter test" << std::endl;
+}
+
+void test_plan_train_matches_interpreter() {
+    Network interpreted, compiled;
+    buildPair(interpreted, compiled, 2, 4, 1);
+    compiled.compile(4);
+
+    Matrix X(4, 2);
+    X.data = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    Matrix Y(4, 1);
+    Y.data = {{0}, {1}, {1}, {0}};
+
+    interpreted.train(X, Y, 50, 0.1);
+    compiled.train(X, Y, 50, 0.1);
+
+    assert(maxDiff(interpreted.predict(X), compiled.predict(X)) < 1e-12);
+
+    std::cout << "[PASS] Compiled train matches interpreter test" << std::endl;
+}
+
+void test_plan_shape_validation() {
+    Network net;
+    net.add(new Dense(3, 4));
+    net.add(new Tanh());
+    net.add(new Dense(5, 1)); // 4 != 5
+
+    bool thrown = false;
+    try {
+        net.compile(8);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(net.getPlan() == nullptr);
+
+    std::cout << "[PASS] Plan shape validation test" << std::endl;
+}
+
+void test_plan_buffer_reuse() {
+    Network net;
+    net.add(new Dense(10, 50));
+    net.add(new Tanh());
+    net.add(new Dense(50, 30));
+    net.add(new Tanh());
+    net.add(new Dense(30, 10));
+    net.add(new Tanh());
+    net.add(new Dense(10, 1));
+    net.add(new Sigmoid());
+    net.compile(32);
+
+    const ExecutionPlan* plan = net.getPlan();
+    assert(plan != nullptr);
+    assert(plan->inputSize() == 10);
+    assert(plan->outputSize() == 1);
+    // Activations run in place and dead Dense outputs are recycled, so the
+    // whole forward pass ping-pongs between two buffers.
+    assert(plan->inferenceBufferCount() == 2);
+    assert(plan->getSteps()[6].kernel == kernels::DenseKernel::Dot);
+
+    net.add(new Tanh());
+    assert(net.getPlan() == nullptr);
+
+    std::cout << "[PASS] Plan buffer reuse test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running ExecutionPlan tests..." << std::endl;
+
+    test_plan_predict_matches_interpreter();
+    test_plan_train_matches_interpreter();
+    test_plan_shape_validation();
+    test_plan_buffer_reuse();
+
+    std::cout << "\nAll ExecutionPlan tests passed!" << std::endl;
+    return 0;
+}
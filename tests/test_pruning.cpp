@@ -0,0 +1,232 @@
+#include "../src/Network.h"
+#include "../src/Pruning.h"
+#include "../src/ModelZoo.h"
+#include "../src/losses/MSE.h"
+#include "../src/layers/BlockSparseDense.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Fraction of 4 x 8 tiles of W that are entirely zero
+static double zeroTiles(const Matrix& W) {
+    int tiles = 0, zero = 0;
+    for (int k0 = 0; k0 < W.rows; k0 += 4) {
+        for (int j0 = 0; j0 < W.cols; j0 += 8) {
+            bool all_zero = true;
+            for (int k = k0; k < std::min(W.rows, k0 + 4); ++k)
+                for (int j = j0; j < std::min(W.cols, j0 + 8); ++j) all_zero = all_zero && W.data[k][j] == 0.0;
+            tiles++;
+            zero += all_zero;
+        }
+    }
+    return (double)zero / tiles;
+}
+
+void test_prune_smallest_blocks() {
+    // 8 x 16 weights = 2 x 2 tiles; tile (kb, jb) filled with (kb * 2 + jb + 1)
+    Network net;
+    Dense* dense = new Dense(8, 16);
+    net.add(dense);
+    for (int k = 0; k < 8; ++k)
+        for (int j = 0; j < 16; ++j) dense->weights.data[k][j] = (k / 4) * 2 + j / 8 + 1;
+
+    PruningOptions options;
+    options.prune_output_layer = true;
+    BlockPruner pruner(net, options);
+    assert(pruner.layerCount() == 1);
+
+    pruner.prune(0.5);
+    assert(pruner.sparsity() == 0.5);
+    // The tiles holding 1 and 2 go, 3 and 4 stay
+    assert(dense->weights.data[0][0] == 0.0 && dense->weights.data[0][8] == 0.0);
+    assert(dense->weights.data[4][0] == 3.0 && dense->weights.data[4][8] == 4.0);
+
+    // Masks are sticky: regrown weights are cleared again
+    dense->weights.data[0][0] = 100.0;
+    pruner.applyMasks();
+    assert(dense->weights.data[0][0] == 0.0);
+    pruner.prune(0.75);
+    assert(dense->weights.data[4][0] == 0.0 && dense->weights.data[4][8] == 4.0);
+
+    std::cout << "[PASS] Block magnitude pruning test" << std::endl;
+}
+
+void test_schedule() {
+    Network net;
+    net.add(new Dense(4, 8));
+    net.add(new Dense(8, 1));
+    PruningOptions options;
+    options.sparsity = 0.8;
+    options.start_epoch = 10;
+    options.end_epoch = 50;
+    options.every = 5;
+    BlockPruner pruner(net, options);
+    assert(pruner.layerCount() == 1); // the output layer is left alone
+
+    assert(pruner.scheduledSparsity(0, 100) == 0.0);
+    assert(pruner.scheduledSparsity(10, 100) == 0.0);
+    assert(pruner.scheduledSparsity(50, 100) == 0.8);
+    assert(pruner.scheduledSparsity(99, 100) == 0.8);
+    double previous = 0.0;
+    for (int e = 10; e <= 50; ++e) {
+        double s = pruner.scheduledSparsity(e, 100);
+        assert(s >= previous);
+        previous = s;
+    }
+    // Cubic: most of the pruning happens early in the ramp
+    assert(pruner.scheduledSparsity(30, 100) > 0.8 * 0.8);
+
+    assert(!pruner.prunesAt(5, 100) && pruner.prunesAt(10, 100) && !pruner.prunesAt(12, 100));
+    assert(pruner.prunesAt(15, 100) && pruner.prunesAt(50, 100) && !pruner.prunesAt(55, 100));
+
+    std::cout << "[PASS] Gradual pruning schedule test" << std::endl;
+}
+
+void test_block_sparse_matches_dense() {
+    Random::seed(31);
+    // Odd shapes exercise the zero-padded edge tiles; width 1 is the Dot kernel
+    for (int out : {1, 13, 40}) {
+        Network net;
+        Dense* dense = new Dense(11, out);
+        dense->bias.setRandom();
+        net.add(dense);
+        PruningOptions options;
+        options.prune_output_layer = true;
+        BlockPruner(net, options).prune(0.6);
+
+        BlockSparseDense sparse(*dense, 4, 8);
+        assert(std::abs((1.0 - sparse.density()) - zeroTiles(dense->weights)) < 1e-12);
+        Matrix back = sparse.toDense();
+        for (int k = 0; k < 11; ++k)
+            for (int j = 0; j < out; ++j) assert(back.data[k][j] == dense->weights.data[k][j]);
+
+        Matrix x(7, 11);
+        x.setRandom();
+        Matrix expected = dense->forward(x);
+        Matrix actual = sparse.forward(x);
+        for (int i = 0; i < 7; ++i)
+            for (int j = 0; j < out; ++j) assert(actual.data[i][j] == expected.data[i][j]);
+
+        // Backward: same input gradient; the stored tiles get the dense update
+        Matrix g(7, out);
+        g.setRandom();
+        Matrix dx_dense = dense->backward(g, 0.1);
+        Matrix dx_sparse = sparse.backward(g, 0.1);
+        for (int i = 0; i < 7; ++i)
+            for (int k = 0; k < 11; ++k) assert(std::abs(dx_sparse.data[i][k] - dx_dense.data[i][k]) < 1e-12);
+        Matrix updated = sparse.toDense();
+        for (int k = 0; k < 11; ++k) {
+            for (int j = 0; j < out; ++j) {
+                if (back.data[k][j] == 0.0 && updated.data[k][j] == 0.0) continue; // pruned tile
+                assert(std::abs(updated.data[k][j] - dense->weights.data[k][j]) < 1e-12);
+            }
+        }
+        for (int j = 0; j < out; ++j) assert(std::abs(sparse.bias.data[0][j] - dense->bias.data[0][j]) < 1e-12);
+    }
+
+    std::cout << "[PASS] Block-sparse kernel vs dense test" << std::endl;
+}
+
+void test_fit_prunes_and_converts() {
+    Matrix X, Y;
+    models::makeLargeDataset(400, X, Y);
+    Random::seed(32);
+    Network net;
+    net.add(new Dense(10, 48));
+    net.add(new Tanh());
+    net.add(new Dense(48, 32));
+    net.add(new Tanh());
+    net.add(new Dense(32, 1));
+    net.add(new Sigmoid());
+
+    TrainingOptions options;
+    options.epochs = 80;
+    options.schedule = LearningRateSchedule::constant(0.1);
+    options.batch_size = 100;
+    options.verbose_every = 0;
+    options.pruning.sparsity = 0.75;
+    net.fit(X, Y, options);
+
+    // 18 tiles in the first layer: floor(0.75 * 18) = 13 are pruned
+    const std::vector<Layer*>& layers = net.getLayers();
+    assert(zeroTiles(static_cast<Dense*>(layers[0])->weights) >= 13.0 / 18);
+    assert(zeroTiles(static_cast<Dense*>(layers[2])->weights) >= 0.75);
+    assert(zeroTiles(static_cast<Dense*>(layers[4])->weights) == 0.0);
+
+    Matrix before = net.predict(X);
+    assert(net.convertToBlockSparse(4, 8, 0.5) == 2);
+    assert(dynamic_cast<BlockSparseDense*>(net.getLayers()[0]));
+    assert(dynamic_cast<Dense*>(net.getLayers()[4]));
+
+    net.compile(128);
+    assert(net.getPlan()->getSteps()[0].op == ExecutionPlan::Op::SparseDense);
+    assert(net.getPlan()->isReentrant());
+    Matrix after = net.predict(X);
+    for (int i = 0; i < X.rows; ++i) assert(after.data[i][0] == before.data[i][0]);
+
+    // The compiled plan also trains the sparse layers, keeping them sparse
+    Matrix xb(128, 10), yb(128, 1);
+    for (int i = 0; i < 128; ++i) {
+        xb.data[i] = X.data[i];
+        yb.data[i] = Y.data[i];
+    }
+    options.epochs = 5;
+    options.batch_size = 0;
+    options.pruning.sparsity = 0.0;
+    net.fit(xb, yb, options);
+    BlockSparseDense* first = static_cast<BlockSparseDense*>(net.getLayers()[0]);
+    assert(zeroTiles(first->toDense()) >= 13.0 / 18);
+
+    std::cout << "[PASS] Pruning during fit and conversion test" << std::endl;
+}
+
+void test_restore_best_after_pruning() {
+    Matrix X, Y;
+    models::makeLargeDataset(400, X, Y);
+    Matrix x_train(300, 10), y_train(300, 1), x_val(100, 10), y_val(100, 1);
+    for (int i = 0; i < 400; ++i) {
+        (i < 300 ? x_train : x_val).data[i % 300] = X.data[i];
+        (i < 300 ? y_train : y_val).data[i % 300] = Y.data[i];
+    }
+    Random::seed(33);
+    Network net;
+    net.add(new Dense(10, 48));
+    net.add(new Tanh());
+    net.add(new Dense(48, 32));
+    net.add(new Tanh());
+    net.add(new Dense(32, 1));
+    net.add(new Sigmoid());
+
+    TrainingOptions options;
+    options.epochs = 80;
+    options.schedule = LearningRateSchedule::constant(0.1);
+    options.validation_every = 5;
+    options.patience = 2;
+    options.restore_best = true;
+    options.verbose_every = 0;
+    options.pruning.sparsity = 0.9;
+    TrainingHistory history = net.fit(x_train, y_train, x_val, y_val, options);
+
+    // floor(0.9 * 18) + floor(0.9 * 48) of 66 tiles, reached despite patience
+    assert(history.sparsity == 59.0 / 66);
+    assert(history.best_epoch > 60); // the pruning ramp ends at epoch 60
+    assert(zeroTiles(static_cast<Dense*>(net.getLayers()[0])->weights) >= 16.0 / 18);
+    assert(zeroTiles(static_cast<Dense*>(net.getLayers()[2])->weights) >= 43.0 / 48);
+    // The restored weights are the ones the best validation loss was measured on
+    assert(std::abs(MSE::loss(y_val, net.predict(x_val)) - history.best_validation_loss) < 1e-12);
+
+    std::cout << "[PASS] Restore best with pruning test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Pruning tests..." << std::endl;
+
+    test_prune_smallest_blocks();
+    test_schedule();
+    test_block_sparse_matches_dense();
+    test_fit_prunes_and_converts();
+    test_restore_best_after_pruning();
+
+    std::cout << "\nAll Pruning tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "../src/Network.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include "../src/layers/Dropout.h"
+#include "TestData.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+void test_philox_known_answers() {
+    // Reference vectors from the Random123 distribution
+    rng::Block r = rng::philox4x32(0, 0, 0, 0, 0, 0);
+    assert(r.v[0] == 0x6627e8d5 && r.v[1] == 0xe169c58d && r.v[2] == 0xbc57ac4c && r.v[3] == 0x9b00dbd8);
+
+    r = rng::philox4x32(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff);
+    assert(r.v[0] == 0x408f276d && r.v[1] == 0x41c83b0e && r.v[2] == 0xa20bc7c6 && r.v[3] == 0x6d5451fd);
+
+    r = rng::philox4x32(0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0);
+    assert(r.v[0] == 0xd16cfe09 && r.v[1] == 0x94fdcceb && r.v[2] == 0x5001e420 && r.v[3] == 0x24126ea1);
+
+    std::cout << "[PASS] Philox known-answer test" << std::endl;
+}
+
+void test_fill_independent_of_threads() {
+    const size_t n = 100001;
+    std::vector<double> one(n), four(n);
+    Random::fillNormal(one.data(), n, 0, 0.0, 1.0, 7, 3, 1);
+    Random::fillNormal(four.data(), n, 0, 0.0, 1.0, 7, 3, 4);
+    assert(one == four);
+
+    // A fill starting at an odd offset sees the same elements
+    std::vector<double> part(1000);
+    Random::fillNormal(part.data(), part.size(), 12345, 0.0, 1.0, 7, 3, 2);
+    for (size_t i = 0; i < part.size(); ++i) {
+        assert(part[i] == one[12345 + i]);
+    }
+
+    // Roughly standard normal
+    double mean = 0.0, sq = 0.0;
+    for (double v : one) {
+        mean += v;
+        sq += v * v;
+    }
+    mean /= n;
+    double var = sq / n - mean * mean;
+    assert(std::abs(mean) < 0.02);
+    assert(std::abs(var - 1.0) < 0.02);
+
+    // Different streams differ
+    std::vector<double> other(n);
+    Random::fillNormal(other.data(), n, 0, 0.0, 1.0, 7, 4, 4);
+    assert(other != one);
+
+    std::cout << "[PASS] Thread-independent fill test" << std::endl;
+}
+
+void test_seeded_initialization() {
+    Random::seed(123);
+    Matrix a(64, 32);
+    a.setRandom();
+    Matrix b(64, 32);
+    b.setRandom();
+
+    Random::seed(123);
+    Matrix c(64, 32);
+    c.setRandom();
+    assert(a.data == c.data);
+    assert(a.data != b.data);
+
+    // Explicit seed and stream, any thread count
+    Matrix d(300, 200), e(300, 200);
+    d.setRandom(9, 1, 1);
+    e.setRandom(9, 1, 8);
+    assert(d.data == e.data);
+
+    std::cout << "[PASS] Seeded initialization test" << std::endl;
+}
+
+void test_shuffle() {
+    std::vector<int> a(1000), b;
+    for (int i = 0; i < 1000; ++i) a[i] = i;
+    b = a;
+    Random::shuffle(a, 5, 0);
+    Random::shuffle(b, 5, 0);
+    assert(a == b);
+
+    std::vector<int> sorted = a;
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < 1000; ++i) assert(sorted[i] == i);
+
+    int fixed = 0;
+    for (int i = 0; i < 1000; ++i) fixed += (a[i] == i);
+    assert(fixed < 10);
+
+    std::cout << "[PASS] Shuffle test" << std::endl;
+}
+
+void test_dropout() {
+    Dropout dropout(0.25);
+    Matrix x(100, 100);
+    for (int i = 0; i < 100; ++i)
+        for (int j = 0; j < 100; ++j) x.data[i][j] = 1.0;
+
+    // Inference: identity
+    Matrix y = dropout.forward(x);
+    assert(y.data == x.data);
+
+    dropout.setTraining(true);
+    y = dropout.forward(x);
+    int kept = 0;
+    for (int i = 0; i < 100; ++i) {
+        for (int j = 0; j < 100; ++j) {
+            if (y.data[i][j] != 0.0) {
+                assert(std::abs(y.data[i][j] - 1.0 / 0.75) < 1e-12);
+                ++kept;
+            }
+        }
+    }
+    assert(std::abs(kept / 10000.0 - 0.75) < 0.02);
+    assert(dropout.getMask().size() == (10000 + 63) / 64);
+
+    // Backward passes gradient through the same units
+    Matrix g = dropout.backward(x, 0.1);
+    assert(g.data == y.data);
+
+    // A new mask on the next call
+    Matrix y2 = dropout.forward(x);
+    assert(y2.data != y.data);
+
+    std::cout << "[PASS] Dropout test" << std::endl;
+}
+
+static double trainWithSeed(uint64_t seed) {
+    Random::seed(seed);
+    Network net;
+    net.add(new Dense(2, 16));
+    net.add(new Tanh());
+    net.add(new Dropout(0.1));
+    net.add(new Dense(16, 1));
+    net.add(new Sigmoid());
+
+    Matrix X, Y;
+    makeData(64, X, Y);
+
+    TrainingOptions options;
+    options.epochs = 50;
+    options.batch_size = 16;
+    options.schedule = LearningRateSchedule::constant(0.1);
+    options.verbose_every = 0;
+    TrainingHistory history = net.fit(X, Y, options);
+    assert((int)history.train_loss.size() == 50);
+    return history.train_loss.back();
+}
+
+void test_reproducible_training() {
+    double a = trainWithSeed(2024);
+    double b = trainWithSeed(2024);
+    double c = trainWithSeed(2025);
+    assert(a == b);
+    assert(a != c);
+
+    std::cout << "[PASS] Reproducible mini-batch training test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Random tests..." << std::endl;
+
+    test_philox_known_answers();
+    test_fill_independent_of_threads();
+    test_seeded_initialization();
+    test_shuffle();
+    test_dropout();
+    test_reproducible_training();
+
+    std::cout << "\nAll Random tests passed!" << std::endl;
+    return 0;
+}
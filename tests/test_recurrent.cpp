@@ -0,0 +1,162 @@
+#include "../src/Network.h"
+#include "../src/layers/Recurrent.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// E = sum(w * layer(x)), with its gradients checked by central differences:
+// the input gradient directly, the parameter gradients as the change a
+// backward() with learning rate 1 makes to each parameter.
+static void checkGradients(Recurrent& layer, int batch) {
+    Matrix x(batch, layer.inputSize());
+    x.setRandom();
+    Matrix w(batch, layer.outputSize(layer.inputSize()));
+    w.setRandom();
+
+    auto energy = [&](const Matrix& in) {
+        Matrix y = layer.forward(in);
+        double e = 0;
+        for (int i = 0; i < y.rows; ++i)
+            for (int j = 0; j < y.cols; ++j) e += w.data[i][j] * y.data[i][j];
+        return e;
+    };
+
+    const double eps = 1e-6;
+    layer.forward(x);
+    Matrix grad = layer.backward(w, 0.0);
+    for (int i = 0; i < x.rows; ++i) {
+        for (int j = 0; j < x.cols; ++j) {
+            Matrix xp = x, xm = x;
+            xp.data[i][j] += eps;
+            xm.data[i][j] -= eps;
+            double numeric = (energy(xp) - energy(xm)) / (2 * eps);
+            assert(std::abs(numeric - grad.data[i][j]) < 1e-5);
+        }
+    }
+
+    std::vector<Matrix*> params = layer.parameters();
+    std::vector<Matrix> before;
+    for (Matrix* p : params) before.push_back(*p);
+    layer.forward(x);
+    layer.backward(w, 1.0);
+    std::vector<Matrix> analytic;
+    for (size_t p = 0; p < params.size(); ++p) {
+        analytic.push_back(before[p] - *params[p]);
+        *params[p] = before[p];
+    }
+
+    for (size_t p = 0; p < params.size(); ++p) {
+        Matrix& m = *params[p];
+        for (int i = 0; i < m.rows; ++i) {
+            for (int j = 0; j < m.cols; ++j) {
+                double saved = m.data[i][j];
+                m.data[i][j] = saved + eps;
+                double ep = energy(x);
+                m.data[i][j] = saved - eps;
+                double em = energy(x);
+                m.data[i][j] = saved;
+                assert(std::abs((ep - em) / (2 * eps) - analytic[p].data[i][j]) < 1e-5);
+            }
+        }
+    }
+}
+
+void test_lstm_shapes() {
+    LSTM last(3, 5, 4);
+    LSTM sequence(3, 5, 4, true);
+    assert(last.inputSize() == 15 && last.outputSize(15) == 4);
+    assert(sequence.outputSize(15) == 20);
+
+    Matrix x(2, 15);
+    x.setRandom();
+    sequence.U = last.U;
+    sequence.W = last.W;
+    sequence.bias = last.bias;
+    Matrix y_last = last.forward(x);
+    Matrix y_seq = sequence.forward(x);
+    assert(y_last.rows == 2 && y_last.cols == 4 && y_seq.cols == 20);
+    // The last hidden state is the final block of the full sequence
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 4; ++j) assert(y_last.data[i][j] == y_seq.data[i][16 + j]);
+
+    std::cout << "[PASS] LSTM shapes test" << std::endl;
+}
+
+void test_batch_matches_single_rows() {
+    GRU gru(2, 6, 5, true);
+    Matrix x(4, 12);
+    x.setRandom();
+    Matrix batched = gru.forward(x);
+    // Reusing the buffers at another batch size must not leak state
+    for (int i = 0; i < 4; ++i) {
+        Matrix row(1, 12);
+        row.data[0] = x.data[i];
+        Matrix single = gru.forward(row);
+        for (int j = 0; j < 30; ++j) assert(std::abs(single.data[0][j] - batched.data[i][j]) < 1e-12);
+    }
+
+    std::cout << "[PASS] Batch vs single-row forward test" << std::endl;
+}
+
+void test_lstm_gradients() {
+    Random::seed(11);
+    LSTM last(3, 4, 5);
+    checkGradients(last, 2);
+    LSTM sequence(2, 3, 4, true);
+    checkGradients(sequence, 3);
+
+    std::cout << "[PASS] LSTM gradient test" << std::endl;
+}
+
+void test_gru_gradients() {
+    Random::seed(12);
+    GRU last(3, 4, 5);
+    last.recurrent_bias.setRandom();
+    checkGradients(last, 2);
+    GRU sequence(2, 3, 4, true);
+    checkGradients(sequence, 3);
+
+    std::cout << "[PASS] GRU gradient test" << std::endl;
+}
+
+void test_lstm_learns_memory_task() {
+    // Output the first value of a 6-step sequence: the answer has to be
+    // carried through five recurrent steps
+    Random::seed(13);
+    const int n = 64, T = 6;
+    Matrix X(n, T), Y(n, 1);
+    X.setRandom();
+    for (int i = 0; i < n; ++i) Y.data[i][0] = X.data[i][0] > 0 ? 1.0 : 0.0;
+
+    Network net;
+    net.add(new LSTM(1, T, 8));
+    net.add(new Dense(8, 1));
+    net.add(new Sigmoid());
+
+    TrainingOptions options;
+    options.epochs = 300;
+    options.schedule = LearningRateSchedule::constant(0.5);
+    options.verbose_every = 0;
+    TrainingHistory history = net.fit(X, Y, options);
+    assert(history.train_loss.back() < history.train_loss.front() * 0.5);
+
+    Metrics m = net.evaluate(X, Y);
+    assert(m.accuracy() > 0.9);
+
+    std::cout << "[PASS] LSTM memory task test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Recurrent tests..." << std::endl;
+
+    test_lstm_shapes();
+    test_batch_matches_single_rows();
+    test_lstm_gradients();
+    test_gru_gradients();
+    test_lstm_learns_memory_task();
+
+    std::cout << "\nAll Recurrent tests passed!" << std::endl;
+    return 0;
+}
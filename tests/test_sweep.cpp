@@ -0,0 +1,117 @@
+#include "../src/Sweep.h"
+#include "../src/Parallel.h"
+#include "TestData.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <atomic>
+#include <stdexcept>
+
+void test_work_stealing() {
+    std::vector<std::atomic<int>> runs(200);
+    for (std::atomic<int>& r : runs) r = 0;
+
+    // One worker's tasks are far slower than the rest, so others must steal
+    std::vector<std::function<void()>> tasks;
+    for (int t = 0; t < 200; ++t) {
+        tasks.push_back([t, &runs]() {
+            volatile double x = 0;
+            int work = (t % 4 == 0) ? 200000 : 1000;
+            for (int i = 0; i < work; ++i) x = x + i;
+            runs[t]++;
+        });
+    }
+    parallel::runWorkStealing(tasks, 4);
+    for (std::atomic<int>& r : runs) assert(r == 1);
+
+    // Exceptions reach the caller
+    std::vector<std::function<void()>> failing = {[]() {}, []() { throw std::runtime_error("x"); }};
+    bool threw = false;
+    try {
+        parallel::runWorkStealing(failing, 2);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "[PASS] Work-stealing runner test" << std::endl;
+}
+
+void test_search_space() {
+    SearchSpace space;
+    space.hidden = {{4}, {8, 4}};
+    space.activations = {Activation::Kind::Tanh, Activation::Kind::Sigmoid};
+    space.learning_rates = {0.01, 0.1, 1.0};
+    space.epochs = {10};
+    assert(space.grid().size() == 12);
+
+    std::vector<SweepConfig> a = space.sample(20, 3);
+    std::vector<SweepConfig> b = space.sample(20, 3);
+    assert(a.size() == 20);
+    for (size_t i = 0; i < a.size(); ++i) {
+        assert(a[i].hidden == b[i].hidden && a[i].learning_rate == b[i].learning_rate);
+        assert(a[i].learning_rate >= 0.01 * (1 - 1e-12) && a[i].learning_rate <= 1.0 * (1 + 1e-12));
+    }
+
+    std::cout << "[PASS] Search space test" << std::endl;
+}
+
+void test_sweep_ranks_and_prunes() {
+    Matrix X, Y, Xv, Yv;
+    makeData(64, X, Y);
+    makeData(32, Xv, Yv);
+
+    SearchSpace space;
+    space.hidden = {{4}, {8}, {8, 4}};
+    space.learning_rates = {0.001, 0.5};
+    space.epochs = {60};
+    std::vector<SweepConfig> configs = space.grid();
+
+    SweepOptions options;
+    options.rung_epochs = 20;
+    options.eta = 2;
+    options.threads = 4;
+    SweepReport report = HyperparameterSweep(X, Y, Xv, Yv, options).run(configs);
+
+    // 6 trials -> 3 after the first rung -> 2 after the second -> finished
+    assert(report.results.size() == 6);
+    int finished = 0;
+    for (const TrialResult& r : report.results) {
+        if (!r.pruned) {
+            assert(r.epochs_run == 60);
+            finished++;
+        } else {
+            assert(r.epochs_run < 60);
+        }
+    }
+    assert(finished == 2);
+    assert(!report.results[0].pruned);
+    assert(report.results[0].validation_loss <= report.results[1].validation_loss);
+    assert(report.results[0].config.learning_rate == 0.5);
+
+    // Same ranking and losses with a single thread
+    options.threads = 1;
+    SweepReport serial = HyperparameterSweep(X, Y, Xv, Yv, options).run(configs);
+    for (size_t i = 0; i < 6; ++i) {
+        assert(serial.results[i].trial == report.results[i].trial);
+        assert(serial.results[i].validation_loss == report.results[i].validation_loss);
+    }
+
+    // Without halving everything runs to the end
+    options.eta = 1;
+    SweepReport full = HyperparameterSweep(X, Y, Xv, Yv, options).run(configs);
+    for (const TrialResult& r : full.results) assert(!r.pruned && r.epochs_run == 60);
+
+    std::cout << "[PASS] Sweep ranking and pruning test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Sweep tests..." << std::endl;
+
+    test_work_stealing();
+    test_search_space();
+    test_sweep_ranks_and_prunes();
+
+    std::cout << "\nAll Sweep tests passed!" << std::endl;
+    return 0;
+}
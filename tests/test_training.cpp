@@ -0,0 +1,124 @@
+#include "../src/Network.h"
+#include "../src/layers/Dense.h"
+#include "../src/layers/Activation.h"
+#include "../src/losses/MSE.h"
+#include "TestData.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+static void buildNet(Network& net) {
+    net.add(new Dense(2, 6));
+    net.add(new Tanh());
+    net.add(new Dense(6, 1));
+    net.add(new Sigmoid());
+}
+
+void test_schedules() {
+    LearningRateSchedule step = LearningRateSchedule::step(0.1, 10, 0.5);
+    assert(std::abs(step.rate(0) - 0.1) < 1e-12);
+    assert(std::abs(step.rate(9) - 0.1) < 1e-12);
+    assert(std::abs(step.rate(10) - 0.05) < 1e-12);
+    assert(std::abs(step.rate(25) - 0.025) < 1e-12);
+
+    LearningRateSchedule cosine = LearningRateSchedule::cosine(1.0, 100, 0.1);
+    assert(std::abs(cosine.rate(0) - 1.0) < 1e-12);
+    assert(std::abs(cosine.rate(50) - 0.55) < 1e-12);
+    assert(std::abs(cosine.rate(100) - 0.1) < 1e-12);
+    assert(std::abs(cosine.rate(500) - 0.1) < 1e-12);
+
+    LearningRateSchedule plateau = LearningRateSchedule::plateau(0.1, 0.5, 2);
+    plateau.observe(1.0);
+    plateau.observe(1.0);
+    assert(std::abs(plateau.rate(0) - 0.1) < 1e-12);
+    plateau.observe(1.0);
+    assert(std::abs(plateau.rate(0) - 0.05) < 1e-12);
+    plateau.observe(0.5); // improvement resets the wait
+    plateau.observe(0.6);
+    assert(std::abs(plateau.rate(0) - 0.05) < 1e-12);
+
+    std::cout << "[PASS] Learning rate schedule test" << std::endl;
+}
+
+void test_validation_split_and_full_run() {
+    Matrix X, Y;
+    makeData(50, X, Y);
+    Network net;
+    buildNet(net);
+
+    TrainingOptions options;
+    options.epochs = 30;
+    options.schedule = LearningRateSchedule::constant(0.5);
+    options.validation_split = 0.2;
+    options.validation_every = 10;
+    options.validation_batch = 3; // uneven batches
+    options.verbose_every = 0;
+
+    TrainingHistory history = net.fit(X, Y, options);
+    assert(history.epochs_run == 30);
+    assert(!history.stopped_early);
+    assert(history.train_loss.size() == 30);
+    assert(history.validation_loss.size() == 3);
+
+    std::cout << "[PASS] Validation split test" << std::endl;
+}
+
+void test_early_stopping() {
+    Matrix X, Y;
+    makeData(40, X, Y);
+    Network net;
+    buildNet(net);
+
+    // A zero learning rate never improves after the first check
+    TrainingOptions options;
+    options.epochs = 1000;
+    options.schedule = LearningRateSchedule::constant(0.0);
+    options.validation_split = 0.25;
+    options.validation_every = 5;
+    options.patience = 3;
+    options.verbose_every = 0;
+
+    TrainingHistory history = net.fit(X, Y, options);
+    assert(history.stopped_early);
+    assert(history.best_epoch == 5);
+    assert(history.epochs_run == 20);
+
+    std::cout << "[PASS] Early stopping test" << std::endl;
+}
+
+void test_restore_best_weights() {
+    Matrix X, Y;
+    makeData(40, X, Y);
+    Matrix X_val, Y_val;
+    makeData(60, X_val, Y_val);
+
+    Network net;
+    buildNet(net);
+
+    // A rate this large makes training unstable, so later epochs are worse
+    TrainingOptions options;
+    options.epochs = 200;
+    options.schedule = LearningRateSchedule::step(5.0, 50, 4.0);
+    options.validation_every = 1;
+    options.restore_best = true;
+    options.verbose_every = 0;
+
+    TrainingHistory history = net.fit(X, Y, X_val, Y_val, options);
+    double restored = MSE::loss(Y_val, net.predict(X_val));
+    assert(std::abs(restored - history.best_validation_loss) < 1e-12);
+    assert(history.best_validation_loss <= history.validation_loss.back());
+
+    std::cout << "[PASS] Restore best weights test" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Training loop tests..." << std::endl;
+
+    test_schedules();
+    test_validation_split_and_full_run();
+    test_early_stopping();
+    test_restore_best_weights();
+
+    std::cout << "\nAll Training loop tests passed!" << std::endl;
+    return 0;
+}